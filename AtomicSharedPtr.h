@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// A shared_ptr that several threads may load and store concurrently.
+//
+// Where the standard library provides a sound std::atomic<std::shared_ptr<T>>
+// it is used directly. libstdc++ is excluded: its load() drops the internal
+// lock with relaxed ordering (seen in GCC 12), so a later store can race with
+// the pointer read. Elsewhere, including every C++17 build, a mutex owned by
+// this object guards the pointer. That replaces std::atomic_load/atomic_store
+// on shared_ptr, which C++20 deprecates and which serialise on a global pool
+// of mutexes shared by unrelated pointers.
+//
+// Neither form is lock-free in mainstream libraries. A load never waits for a
+// writer's work, only for another thread's load or store of this same
+// pointer, which is a reference count update long.
+template <typename T> class AtomicSharedPtr {
+public:
+  // Construction
+  AtomicSharedPtr() noexcept; // Holds nullptr
+  explicit AtomicSharedPtr(std::shared_ptr<T> value) noexcept;
+  AtomicSharedPtr(const AtomicSharedPtr &) = delete;
+  AtomicSharedPtr &operator=(const AtomicSharedPtr &) = delete;
+
+  // Behaviors
+  std::shared_ptr<T> Load() const;      // Current pointer, with a reference
+  void Store(std::shared_ptr<T> value); // Publish value
+
+private:
+#if defined(__cpp_lib_atomic_shared_ptr) && !defined(__GLIBCXX__)
+  std::atomic<std::shared_ptr<T>> _value; // Published pointer
+#else
+  mutable std::mutex _lock;  // Held only while _value is copied or swapped
+  std::shared_ptr<T> _value; // Published pointer
+#endif
+};
+
+template <typename T> AtomicSharedPtr<T>::AtomicSharedPtr() noexcept {}
+
+template <typename T>
+AtomicSharedPtr<T>::AtomicSharedPtr(std::shared_ptr<T> value) noexcept
+    : _value(std::move(value)) {}
+
+template <typename T> std::shared_ptr<T> AtomicSharedPtr<T>::Load() const {
+#if defined(__cpp_lib_atomic_shared_ptr) && !defined(__GLIBCXX__)
+  return _value.load();
+#else
+  std::lock_guard<std::mutex> guard(_lock);
+  return _value;
+#endif
+}
+
+template <typename T> void AtomicSharedPtr<T>::Store(std::shared_ptr<T> value) {
+#if defined(__cpp_lib_atomic_shared_ptr) && !defined(__GLIBCXX__)
+  _value.store(std::move(value));
+#else
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _value.swap(value);
+  }
+  // value now holds the old version; it is released here, outside the lock
+#endif
+}
@@ -0,0 +1,477 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Doubly-linked list whose nodes live in one contiguous vector and link to each
+// other with 32-bit slot indices instead of pointers. Released slots go onto a
+// free list (threaded through their next field) and are reused before the
+// vector grows, so churn does not scatter the list across the heap.
+//
+// Elements are addressed by Handle, the index of their slot. A handle stays
+// valid until its element is removed, even when the vector reallocates. When
+// T is trivially copyable so is every Slot, and copying the list is a single
+// memcpy of the slot vector.
+template <typename T> class CompactLinkedList {
+public:
+  using Handle = std::uint32_t;
+  static constexpr Handle NullHandle = UINT32_MAX; // Handle of no element
+
+  struct Slot {
+    T data;      // Data stored in the slot
+    Handle next; // Next element, or next free slot when released
+    Handle prev; // Previous element
+  };
+
+  template <bool IsConst>
+  class Iterator; // Declaration of nested bidirectional iterator
+
+  using value_type = T;
+  using size_type = unsigned int;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  // Construction
+  CompactLinkedList(); // Default constructor
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+  void Reserve(unsigned int count); // Make room for count elements
+
+  // Accessors
+  unsigned int NodeCount() const; // Returns _size
+  void FindAll(std::vector<Handle> &outData, const T &value)
+      const; // Returns a vector with all handles containing value
+  Handle Find(const T &data) const; // Handle of first element equal to data
+  Handle GetNode(unsigned int index) const; // Handle of the nth element
+  Handle Head() const;                      // Returns _head
+  Handle Tail() const;                      // Returns _tail
+  Handle Next(Handle handle) const;         // Element after handle
+  Handle Prev(Handle handle) const;         // Element before handle
+  T &Get(Handle handle);                    // Data stored at handle
+  const T &Get(Handle handle) const;        // Data stored at handle
+  const std::vector<Slot> &Slots() const;   // Raw storage, free slots included
+
+  // Iteration
+  iterator begin();             // Iterator to _head
+  const_iterator begin() const; // Iterator to _head
+  iterator end();               // Iterator past _tail
+  const_iterator end() const;   // Iterator past _tail
+
+  // Insertion
+  Handle AddHead(const T &data); // Create new element at front of list
+  Handle AddHead(T &&data);      // Create new element at front of list
+  Handle AddTail(const T &data); // Create new element at end of list
+  Handle AddTail(T &&data);      // Create new element at end of list
+  Handle InsertAfter(Handle handle,
+                     const T &data); // Insert element after handle
+  Handle InsertBefore(Handle handle,
+                      const T &data); // Insert element before handle
+  Handle InsertAt(const T &data,
+                  unsigned int index); // Insert element at given index
+
+  // Removal
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all elements containing data
+  bool RemoveAt(unsigned int index);  // Delete element at index
+  void RemoveNode(Handle handle);     // Delete element at handle
+  void Clear();                       // Delete all elements in list
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  T &operator[](unsigned int index);             // Subscript operator
+  bool operator==(const CompactLinkedList<T> &rhs) const; // Equality operator
+
+private:
+  // Member variables
+  std::vector<Slot> _slots; // Storage for every element and free slot
+  Handle _head;             // First element in list
+  Handle _tail;             // Last element in list
+  Handle _free;             // First released slot
+  unsigned int _size;       // Number of elements in list
+
+  // Private behaviors
+  template <typename U>
+  Handle create_slot(U &&data); // Fill a free (or new) slot with data
+  void link_after(Handle handle, Handle new_handle); // NullHandle = at head
+};
+
+// Nested bidirectional iterator for CompactLinkedList class
+template <typename T>
+template <bool IsConst>
+class CompactLinkedList<T>::Iterator {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<IsConst, const T *, T *>::type;
+  using reference = typename std::conditional<IsConst, const T &, T &>::type;
+  using list_pointer = typename std::conditional<IsConst,
+                                                 const CompactLinkedList *,
+                                                 CompactLinkedList *>::type;
+
+  Iterator() : _list(nullptr), _handle(NullHandle) {}
+  Iterator(list_pointer list, Handle handle) : _list(list), _handle(handle) {}
+
+  reference operator*() const { return _list->_slots[_handle].data; }
+  pointer operator->() const { return &_list->_slots[_handle].data; }
+  Handle GetHandle() const { return _handle; } // Handle of current element
+
+  Iterator &operator++() {
+    _handle = _list->_slots[_handle].next;
+    return *this;
+  }
+  Iterator operator++(int) {
+    Iterator previous = *this;
+    ++*this;
+    return previous;
+  }
+  Iterator &operator--() {
+    _handle =
+        _handle == NullHandle ? _list->_tail : _list->_slots[_handle].prev;
+    return *this;
+  }
+  Iterator operator--(int) {
+    Iterator previous = *this;
+    --*this;
+    return previous;
+  }
+
+  friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._handle == rhs._handle;
+  }
+  friend bool operator!=(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._handle != rhs._handle;
+  }
+
+private:
+  list_pointer _list; // List the handle belongs to
+  Handle _handle;     // Current element; NullHandle once past _tail
+};
+
+template <typename T> CompactLinkedList<T>::CompactLinkedList() {
+  _head = NullHandle;
+  _tail = NullHandle;
+  _free = NullHandle;
+  _size = 0;
+}
+
+template <typename T> void CompactLinkedList<T>::PrintForward() const {
+  for (Handle handle = _head; handle != NullHandle;
+       handle = _slots[handle].next) {
+    std::cout << _slots[handle].data << std::endl;
+  }
+}
+
+template <typename T> void CompactLinkedList<T>::PrintReverse() const {
+  for (Handle handle = _tail; handle != NullHandle;
+       handle = _slots[handle].prev) {
+    std::cout << _slots[handle].data << std::endl;
+  }
+}
+
+template <typename T>
+void CompactLinkedList<T>::Reserve(unsigned int count) {
+  _slots.reserve(count);
+}
+
+template <typename T> unsigned int CompactLinkedList<T>::NodeCount() const {
+  return _size;
+}
+
+template <typename T>
+void CompactLinkedList<T>::FindAll(std::vector<Handle> &outData,
+                                   const T &value) const {
+  for (Handle handle = _head; handle != NullHandle;
+       handle = _slots[handle].next) {
+    if (_slots[handle].data == value) {
+      outData.push_back(handle);
+    }
+  }
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::Find(const T &data) const {
+  Handle handle = _head;
+  while (handle != NullHandle && !(_slots[handle].data == data)) {
+    handle = _slots[handle].next;
+  }
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::GetNode(unsigned int index) const {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  Handle handle;
+  if (index < _size / 2) {
+    handle = _head;
+    for (unsigned int i = 0; i < index; i++) {
+      handle = _slots[handle].next;
+    }
+  } else {
+    handle = _tail;
+    for (unsigned int i = _size - 1; i > index; i--) {
+      handle = _slots[handle].prev;
+    }
+  }
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle CompactLinkedList<T>::Head() const {
+  return _head;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle CompactLinkedList<T>::Tail() const {
+  return _tail;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::Next(Handle handle) const {
+  return _slots[handle].next;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::Prev(Handle handle) const {
+  return _slots[handle].prev;
+}
+
+template <typename T> T &CompactLinkedList<T>::Get(Handle handle) {
+  return _slots[handle].data;
+}
+
+template <typename T> const T &CompactLinkedList<T>::Get(Handle handle) const {
+  return _slots[handle].data;
+}
+
+template <typename T>
+const std::vector<typename CompactLinkedList<T>::Slot> &
+CompactLinkedList<T>::Slots() const {
+  return _slots;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::iterator CompactLinkedList<T>::begin() {
+  return iterator(this, _head);
+}
+
+template <typename T>
+typename CompactLinkedList<T>::const_iterator
+CompactLinkedList<T>::begin() const {
+  return const_iterator(this, _head);
+}
+
+template <typename T>
+typename CompactLinkedList<T>::iterator CompactLinkedList<T>::end() {
+  return iterator(this, NullHandle);
+}
+
+template <typename T>
+typename CompactLinkedList<T>::const_iterator
+CompactLinkedList<T>::end() const {
+  return const_iterator(this, NullHandle);
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::AddHead(const T &data) {
+  Handle handle = create_slot(data);
+  link_after(NullHandle, handle);
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle CompactLinkedList<T>::AddHead(T &&data) {
+  Handle handle = create_slot(std::move(data));
+  link_after(NullHandle, handle);
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::AddTail(const T &data) {
+  Handle handle = create_slot(data);
+  link_after(_tail, handle);
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle CompactLinkedList<T>::AddTail(T &&data) {
+  Handle handle = create_slot(std::move(data));
+  link_after(_tail, handle);
+  return handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::InsertAfter(Handle handle, const T &data) {
+  Handle new_handle = create_slot(data);
+  link_after(handle, new_handle);
+  return new_handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::InsertBefore(Handle handle, const T &data) {
+  Handle new_handle = create_slot(data);
+  link_after(_slots[handle].prev, new_handle);
+  return new_handle;
+}
+
+template <typename T>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::InsertAt(const T &data, unsigned int index) {
+  if (index > _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _size) {
+    return AddTail(data);
+  }
+  return InsertBefore(GetNode(index), data);
+}
+
+template <typename T> bool CompactLinkedList<T>::RemoveHead() {
+  if (_head == NullHandle) {
+    return false;
+  }
+  RemoveNode(_head);
+  return true;
+}
+
+template <typename T> bool CompactLinkedList<T>::RemoveTail() {
+  if (_tail == NullHandle) {
+    return false;
+  }
+  RemoveNode(_tail);
+  return true;
+}
+
+template <typename T>
+unsigned int CompactLinkedList<T>::Remove(const T &data) {
+  const T value = data; // data may alias an element that gets removed
+  unsigned int removed = 0;
+  Handle handle = _head;
+  while (handle != NullHandle) {
+    Handle next = _slots[handle].next;
+    if (_slots[handle].data == value) {
+      RemoveNode(handle);
+      removed++;
+    }
+    handle = next;
+  }
+  return removed;
+}
+
+template <typename T> bool CompactLinkedList<T>::RemoveAt(unsigned int index) {
+  try {
+    RemoveNode(GetNode(index));
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n';
+    return false;
+  }
+}
+
+template <typename T> void CompactLinkedList<T>::RemoveNode(Handle handle) {
+  Slot &slot = _slots[handle];
+  if (slot.prev != NullHandle) {
+    _slots[slot.prev].next = slot.next;
+  } else {
+    _head = slot.next;
+  }
+  if (slot.next != NullHandle) {
+    _slots[slot.next].prev = slot.prev;
+  } else {
+    _tail = slot.prev;
+  }
+  if constexpr (!std::is_trivially_destructible<T>::value) {
+    T released(std::move(slot.data)); // Drop any resources the value holds
+    static_cast<void>(released);
+  }
+  slot.next = _free;
+  slot.prev = NullHandle;
+  _free = handle;
+  _size--;
+}
+
+template <typename T> void CompactLinkedList<T>::Clear() {
+  _slots.clear();
+  _head = NullHandle;
+  _tail = NullHandle;
+  _free = NullHandle;
+  _size = 0;
+}
+
+template <typename T>
+const T &CompactLinkedList<T>::operator[](unsigned int index) const {
+  return _slots[GetNode(index)].data;
+}
+
+template <typename T> T &CompactLinkedList<T>::operator[](unsigned int index) {
+  return _slots[GetNode(index)].data;
+}
+
+template <typename T>
+bool CompactLinkedList<T>::operator==(const CompactLinkedList<T> &rhs) const {
+  if (_size != rhs._size) {
+    return false;
+  }
+  Handle left = _head;
+  Handle right = rhs._head;
+  while (left != NullHandle) {
+    if (!(_slots[left].data == rhs._slots[right].data)) {
+      return false;
+    }
+    left = _slots[left].next;
+    right = rhs._slots[right].next;
+  }
+  return true;
+}
+
+template <typename T>
+template <typename U>
+typename CompactLinkedList<T>::Handle
+CompactLinkedList<T>::create_slot(U &&data) {
+  if (_free != NullHandle) {
+    Handle handle = _free;
+    _free = _slots[handle].next;
+    _slots[handle].data = std::forward<U>(data);
+    return handle;
+  }
+  if (_slots.size() >= NullHandle) {
+    throw std::length_error("Error: List is full.");
+  }
+  _slots.push_back(Slot{std::forward<U>(data), NullHandle, NullHandle});
+  return static_cast<Handle>(_slots.size() - 1);
+}
+
+template <typename T>
+void CompactLinkedList<T>::link_after(Handle handle, Handle new_handle) {
+  Slot &slot = _slots[new_handle];
+  slot.prev = handle;
+  slot.next = handle == NullHandle ? _head : _slots[handle].next;
+  if (slot.next != NullHandle) {
+    _slots[slot.next].prev = new_handle;
+  } else {
+    _tail = new_handle;
+  }
+  if (handle != NullHandle) {
+    _slots[handle].next = new_handle;
+  } else {
+    _head = new_handle;
+  }
+  _size++;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Multi-producer / multi-consumer FIFO queue built on the two-lock variant of
+// the Michael-Scott queue. A dummy node always sits at the front, so producers
+// (PushTail) only ever touch _tail under _tail_lock and consumers (TryPopHead)
+// only ever touch _head under _head_lock; one producer and one consumer never
+// contend with each other. Nodes are allocated and payloads constructed
+// outside the locks.
+//
+// Reclamation needs no hazard pointers or epochs: a node is freed by the
+// consumer that retires it as the dummy, under _head_lock, and at that point
+// no producer can reach it any more (the node a producer links onto is always
+// the current _tail, which a consumer never frees).
+template <typename T> class ConcurrentLinkedQueue {
+public:
+  // Construction / destruction
+  ConcurrentLinkedQueue(); // Default constructor
+  ConcurrentLinkedQueue(const ConcurrentLinkedQueue &) = delete;
+  ConcurrentLinkedQueue &operator=(const ConcurrentLinkedQueue &) = delete;
+  ~ConcurrentLinkedQueue(); // Destructor; no other thread may be using it
+
+  // Insertion
+  void PushTail(const T &data); // Append a copy of data
+  void PushTail(T &&data);      // Append data by moving it
+  template <typename... Args>
+  void EmplaceTail(Args &&...args); // Construct T in a node at the end
+  template <typename InputIt>
+  void PushTailBatch(InputIt first,
+                     InputIt last); // Append a range with one lock acquisition
+
+  // Removal
+  std::optional<T> TryPopHead(); // Pop the oldest value, if any
+  template <typename OutputIt>
+  std::size_t PopHeadBatch(OutputIt out,
+                           std::size_t max_count); // Pop up to max_count
+                                                   // values under one lock
+
+  // Accessors
+  bool Empty() const;        // Snapshot; may be stale by the time it returns
+  std::size_t Size() const;  // Snapshot; may be stale by the time it returns
+
+private:
+  struct Node {
+    std::optional<T> data;    // Empty for the dummy node
+    std::atomic<Node *> next; // Written by producers, read by consumers
+
+    Node() : next(nullptr) {}
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : data(std::in_place, std::forward<Args>(args)...), next(nullptr) {}
+  };
+
+  // Member variables; the two ends live on separate cache lines so producers
+  // and consumers do not false-share
+  alignas(64) std::mutex _head_lock; // Serialises consumers
+  Node *_head;                       // Dummy node in front of the oldest value
+  alignas(64) std::mutex _tail_lock; // Serialises producers
+  Node *_tail;                       // Most recently linked node
+  alignas(64) std::atomic<std::size_t> _size; // Number of queued values
+
+  // Private behaviors
+  void link_chain(Node *first, Node *last,
+                  std::size_t count); // Publish a pre-linked chain at _tail
+  static void delete_chain(Node *first); // Free an unreachable chain
+};
+
+template <typename T> ConcurrentLinkedQueue<T>::ConcurrentLinkedQueue() {
+  _head = new Node();
+  _tail = _head;
+  _size.store(0, std::memory_order_relaxed);
+}
+
+template <typename T> ConcurrentLinkedQueue<T>::~ConcurrentLinkedQueue() {
+  Node *current_node = _head;
+  while (current_node != nullptr) {
+    Node *next = current_node->next.load(std::memory_order_relaxed);
+    delete current_node;
+    current_node = next;
+  }
+}
+
+template <typename T> void ConcurrentLinkedQueue<T>::PushTail(const T &data) {
+  Node *node = new Node(std::in_place, data);
+  link_chain(node, node, 1);
+}
+
+template <typename T> void ConcurrentLinkedQueue<T>::PushTail(T &&data) {
+  Node *node = new Node(std::in_place, std::move(data));
+  link_chain(node, node, 1);
+}
+
+template <typename T>
+template <typename... Args>
+void ConcurrentLinkedQueue<T>::EmplaceTail(Args &&...args) {
+  Node *node = new Node(std::in_place, std::forward<Args>(args)...);
+  link_chain(node, node, 1);
+}
+
+template <typename T>
+template <typename InputIt>
+void ConcurrentLinkedQueue<T>::PushTailBatch(InputIt first, InputIt last) {
+  // Build the chain privately, then publish it with a single link
+  Node *chain_head = nullptr;
+  Node *chain_tail = nullptr;
+  std::size_t count = 0;
+  try {
+    for (; first != last; ++first) {
+      Node *node = new Node(std::in_place, *first);
+      if (chain_tail != nullptr) {
+        chain_tail->next.store(node, std::memory_order_relaxed);
+      } else {
+        chain_head = node;
+      }
+      chain_tail = node;
+      count++;
+    }
+  } catch (...) {
+    delete_chain(chain_head);
+    throw;
+  }
+  if (chain_head != nullptr) {
+    link_chain(chain_head, chain_tail, count);
+  }
+}
+
+template <typename T> std::optional<T> ConcurrentLinkedQueue<T>::TryPopHead() {
+  Node *old_dummy;
+  std::optional<T> value;
+  {
+    std::lock_guard<std::mutex> guard(_head_lock);
+    Node *first = _head->next.load(std::memory_order_acquire);
+    if (first == nullptr) {
+      return value; // Queue is empty
+    }
+    value = std::move(first->data); // first becomes the new dummy
+    first->data.reset();
+    old_dummy = _head;
+    _head = first;
+    _size.fetch_sub(1, std::memory_order_relaxed);
+  }
+  delete old_dummy; // Unreachable by producers; free outside the lock
+  return value;
+}
+
+template <typename T>
+template <typename OutputIt>
+std::size_t ConcurrentLinkedQueue<T>::PopHeadBatch(OutputIt out,
+                                                   std::size_t max_count) {
+  Node *retired = nullptr; // Old dummies, chained for release after unlock
+  std::size_t popped = 0;
+  try {
+    std::lock_guard<std::mutex> guard(_head_lock);
+    while (popped < max_count) {
+      Node *first = _head->next.load(std::memory_order_acquire);
+      if (first == nullptr) {
+        break;
+      }
+      *out = std::move(*first->data); // If this throws, first stays queued
+      ++out;
+      first->data.reset();
+      _head->next.store(retired, std::memory_order_relaxed);
+      retired = _head;
+      _head = first;
+      popped++;
+    }
+    _size.fetch_sub(popped, std::memory_order_relaxed);
+  } catch (...) {
+    // Values already written to out stay popped; account for them and free
+    // their dummies before passing the exception on
+    _size.fetch_sub(popped, std::memory_order_relaxed);
+    delete_chain(retired);
+    throw;
+  }
+  delete_chain(retired);
+  return popped;
+}
+
+template <typename T> bool ConcurrentLinkedQueue<T>::Empty() const {
+  return _size.load(std::memory_order_relaxed) == 0;
+}
+
+template <typename T> std::size_t ConcurrentLinkedQueue<T>::Size() const {
+  return _size.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void ConcurrentLinkedQueue<T>::link_chain(Node *first, Node *last,
+                                          std::size_t count) {
+  std::lock_guard<std::mutex> guard(_tail_lock);
+  _size.fetch_add(count, std::memory_order_relaxed);
+  _tail->next.store(first, std::memory_order_release); // Publish to consumers
+  _tail = last;
+}
+
+template <typename T> void ConcurrentLinkedQueue<T>::delete_chain(Node *first) {
+  while (first != nullptr) {
+    Node *next = first->next.load(std::memory_order_relaxed);
+    delete first;
+    first = next;
+  }
+}
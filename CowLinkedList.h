@@ -0,0 +1,256 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "LinkedList.h"
+
+// LinkedList with copy-on-write sharing. Copies share one reference-counted
+// body, so copying or passing a CowLinkedList by value is O(1); the first
+// mutating call on a copy whose body is shared clones it, and later mutations
+// on that copy run at LinkedList speed. An empty or moved-from list has no
+// body at all.
+//
+// As with any implicitly shared container, a reference obtained from the
+// non-const operator[] or MutableList() must not be kept across a copy of the
+// list: writes through it would show up in both copies.
+//
+// Not thread-safe, even between copies that look independent. Whether a body
+// is shared is decided from shared_ptr::use_count(), which is only a snapshot
+// when other threads hold copies and gives no ordering: a thread can see a
+// count of 1 and write the body in place while another thread is still
+// copying or reading it. Instances that share a body must all be used from one
+// thread at a time, copying included. Before a copy is handed to another
+// thread, unshare it on the sending thread (MutableList() does), so that the
+// two threads never hold the same body. For concurrent readers and writers
+// use SharedLinkedList.
+template <typename T> class CowLinkedList {
+public:
+  using Node = typename LinkedList<T>::Node;
+  using const_iterator = typename LinkedList<T>::const_iterator;
+
+  // Construction
+  CowLinkedList();                                 // Default constructor
+  explicit CowLinkedList(const LinkedList<T> &list); // Start from a copy
+  explicit CowLinkedList(LinkedList<T> &&list);      // Take over list's nodes
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+
+  // Accessors (never clone)
+  unsigned int NodeCount() const; // Number of nodes in the list
+  void FindAll(vector<const Node *> &outData,
+               const T &value) const; // All nodes containing value
+  const Node *Find(const T &data) const; // First node with specified data
+  const Node *GetNode(unsigned int index) const; // Returns the nth node
+  const Node *Head() const;                     // First node
+  const Node *Tail() const;                     // Last node
+  const LinkedList<T> &List() const;            // Read-only view of the body
+  bool IsShared() const; // Whether another copy shares the body; only
+                         // reliable when no other thread holds a copy
+
+  // Iteration
+  const_iterator begin() const; // Iterator to the first node
+  const_iterator end() const;   // Iterator past the last node
+
+  // Mutators (clone the body first if it is shared)
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void AddNodesHead(const T *data,
+                    unsigned int count); // Link array at front of list
+  void AddNodesTail(const T *data,
+                    unsigned int count); // Link array at end of list
+  void InsertAt(const T &data,
+                unsigned int index); // Insert node at given index
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all nodes containing data
+  bool RemoveAt(unsigned int index);  // Delete node at index
+  void Clear();                       // Drop this copy's reference to the body
+  void Sort();                        // Stable sort using operator<
+  LinkedList<T> &MutableList();       // Unshared body, for any other change
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  T &operator[](unsigned int index); // Subscript operator; clones if shared
+  bool operator==(const CowLinkedList<T> &rhs) const; // Equality operator
+
+private:
+  // Member variables
+  std::shared_ptr<LinkedList<T>> _body; // Shared list; nullptr when empty
+
+  // Private behaviors
+  const LinkedList<T> &view() const; // Body, or a shared empty list
+  LinkedList<T> &unshare();          // Give this copy a body of its own
+};
+
+template <typename T> CowLinkedList<T>::CowLinkedList() {}
+
+template <typename T>
+CowLinkedList<T>::CowLinkedList(const LinkedList<T> &list)
+    : _body(std::make_shared<LinkedList<T>>(list)) {}
+
+template <typename T>
+CowLinkedList<T>::CowLinkedList(LinkedList<T> &&list)
+    : _body(std::make_shared<LinkedList<T>>(std::move(list))) {}
+
+template <typename T> void CowLinkedList<T>::PrintForward() const {
+  view().PrintForward();
+}
+
+template <typename T> void CowLinkedList<T>::PrintReverse() const {
+  view().PrintReverse();
+}
+
+template <typename T> unsigned int CowLinkedList<T>::NodeCount() const {
+  return view().NodeCount();
+}
+
+template <typename T>
+void CowLinkedList<T>::FindAll(vector<const Node *> &outData,
+                               const T &value) const {
+  vector<Node *> found;
+  view().FindAll(found, value);
+  outData.insert(outData.end(), found.begin(), found.end());
+}
+
+template <typename T>
+const typename CowLinkedList<T>::Node *
+CowLinkedList<T>::Find(const T &data) const {
+  return view().Find(data);
+}
+
+template <typename T>
+const typename CowLinkedList<T>::Node *
+CowLinkedList<T>::GetNode(unsigned int index) const {
+  return view().GetNode(index);
+}
+
+template <typename T>
+const typename CowLinkedList<T>::Node *CowLinkedList<T>::Head() const {
+  return view().Head();
+}
+
+template <typename T>
+const typename CowLinkedList<T>::Node *CowLinkedList<T>::Tail() const {
+  return view().Tail();
+}
+
+template <typename T> const LinkedList<T> &CowLinkedList<T>::List() const {
+  return view();
+}
+
+template <typename T> bool CowLinkedList<T>::IsShared() const {
+  return _body != nullptr && _body.use_count() > 1;
+}
+
+template <typename T>
+typename CowLinkedList<T>::const_iterator CowLinkedList<T>::begin() const {
+  return view().begin();
+}
+
+template <typename T>
+typename CowLinkedList<T>::const_iterator CowLinkedList<T>::end() const {
+  return view().end();
+}
+
+template <typename T> void CowLinkedList<T>::AddHead(const T &data) {
+  unshare().AddHead(data);
+}
+
+template <typename T> void CowLinkedList<T>::AddTail(const T &data) {
+  unshare().AddTail(data);
+}
+
+template <typename T>
+void CowLinkedList<T>::AddNodesHead(const T *data, unsigned int count) {
+  unshare().AddNodesHead(data, count);
+}
+
+template <typename T>
+void CowLinkedList<T>::AddNodesTail(const T *data, unsigned int count) {
+  unshare().AddNodesTail(data, count);
+}
+
+template <typename T>
+void CowLinkedList<T>::InsertAt(const T &data, unsigned int index) {
+  if (index > NodeCount()) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  unshare().InsertAt(data, index);
+}
+
+template <typename T> bool CowLinkedList<T>::RemoveHead() {
+  return NodeCount() != 0 && unshare().RemoveHead();
+}
+
+template <typename T> bool CowLinkedList<T>::RemoveTail() {
+  return NodeCount() != 0 && unshare().RemoveTail();
+}
+
+template <typename T> unsigned int CowLinkedList<T>::Remove(const T &data) {
+  if (view().Find(data) == nullptr) {
+    return 0; // Nothing to remove, so no reason to clone
+  }
+  return unshare().Remove(data); // A replaced body lives on in its other
+                                 // copies, so data stays valid
+}
+
+template <typename T> bool CowLinkedList<T>::RemoveAt(unsigned int index) {
+  if (index >= NodeCount()) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  return unshare().RemoveAt(index);
+}
+
+template <typename T> void CowLinkedList<T>::Clear() {
+  _body.reset(); // Other copies keep the old body; nothing is cloned
+}
+
+template <typename T> void CowLinkedList<T>::Sort() {
+  if (NodeCount() > 1) {
+    unshare().Sort();
+  }
+}
+
+template <typename T> LinkedList<T> &CowLinkedList<T>::MutableList() {
+  return unshare();
+}
+
+template <typename T>
+const T &CowLinkedList<T>::operator[](unsigned int index) const {
+  return view()[index];
+}
+
+template <typename T> T &CowLinkedList<T>::operator[](unsigned int index) {
+  if (index >= NodeCount()) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  return unshare()[index];
+}
+
+template <typename T>
+bool CowLinkedList<T>::operator==(const CowLinkedList<T> &rhs) const {
+  if (_body == rhs._body) {
+    return true; // Same body (or both empty), so no need to walk it
+  }
+  return view() == rhs.view();
+}
+
+template <typename T> const LinkedList<T> &CowLinkedList<T>::view() const {
+  static const LinkedList<T> empty;
+  return _body != nullptr ? *_body : empty;
+}
+
+template <typename T> LinkedList<T> &CowLinkedList<T>::unshare() {
+  if (_body == nullptr) {
+    _body = std::make_shared<LinkedList<T>>();
+  } else if (_body.use_count() > 1) {
+    _body = std::make_shared<LinkedList<T>>(*_body); // The one real copy
+  }
+  return *_body;
+}
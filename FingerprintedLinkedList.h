@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "LinkedList.h"
+
+// LinkedList that keeps a fingerprint of its contents up to date on every
+// mutation. The fingerprint is the sum of a non-commutative mix of every pair
+// of neighbouring element hashes (with sentinels standing in before _head and
+// after _tail), so linking or unlinking a node only swaps one or two pair
+// terms and costs O(1). operator== rejects lists with different fingerprints
+// without touching a single node and only falls back to the element-by-element
+// compare when the fingerprints agree.
+//
+// The fingerprint sees the multiset of neighbouring pairs, not where each pair
+// sits, so it is only partly order-sensitive. Lists made of the same pairs in
+// a different arrangement always collide: 1 2 1 3 1 and 1 3 1 2 1 both
+// consist of (^,1) (1,2) (2,1) (1,3) (3,1) (1,$). Such collisions are
+// systematic, not a matter of hash quality, and only cost operator== its full
+// compare. A hash over positions would not help here: inserting in the middle
+// shifts every later position, which no O(1) update can account for.
+//
+// Elements are only reachable read-only; use Set() to change a stored value so
+// that the fingerprint follows the change.
+template <typename T, typename Hash = std::hash<T>>
+class FingerprintedLinkedList {
+public:
+  using Node = typename LinkedList<T>::Node;
+  using const_iterator = typename LinkedList<T>::const_iterator;
+
+  // Construction / destruction
+  FingerprintedLinkedList(); // Default constructor
+  FingerprintedLinkedList(const FingerprintedLinkedList &list); // Copy
+  FingerprintedLinkedList(FingerprintedLinkedList &&list);      // Move
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+
+  // Accessors
+  std::uint64_t Fingerprint() const; // Hash of the neighbouring pairs
+  unsigned int NodeCount() const;    // Returns number of nodes
+  const Node *Find(const T &data) const; // First node containing data
+  const Node *GetNode(unsigned int index) const; // Returns the nth node
+  const Node *Head() const;                      // Returns first node
+  const Node *Tail() const;                      // Returns last node
+  const LinkedList<T> &List() const; // Underlying list for read-only use
+  const_iterator begin() const;      // Iterator to first node
+  const_iterator end() const;        // Iterator past last node
+
+  // Insertion
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void AddNodesHead(const T *data,
+                    unsigned int count); // Given array, link nodes at front
+  void AddNodesTail(const T *data,
+                    unsigned int count); // Given array, link nodes at end
+  void InsertAfter(const Node *node,
+                   const T &data); // Insert node after specified node
+  void InsertBefore(const Node *node,
+                    const T &data); // Insert node before specified node
+  void InsertAt(const T &data,
+                unsigned int index); // Insert node at given index
+
+  // Modification
+  void Set(const Node *node, const T &data); // Replace a node's value
+
+  // Removal
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all nodes containing data
+  bool RemoveAt(unsigned int index);  // Delete node at index
+  void RemoveNode(const Node *node);  // Delete specified node
+  void Clear();                       // Delete all nodes in list
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  bool operator==(const FingerprintedLinkedList &rhs)
+      const; // O(1) rejection on fingerprint mismatch
+  bool operator!=(const FingerprintedLinkedList &rhs) const;
+  FingerprintedLinkedList &
+  operator=(const FingerprintedLinkedList &rhs); // Copy assignment operator
+  FingerprintedLinkedList &
+  operator=(FingerprintedLinkedList &&rhs); // Move assignment operator
+
+private:
+  // Member variables
+  LinkedList<T> _list;         // Nodes in list order
+  std::uint64_t _fingerprint; // Sum of pair() over every neighbouring pair
+
+  // Private behaviors
+  void linked(const Node *node);   // Account for node having been linked
+  void unlinking(const Node *node); // Account for node about to be unlinked
+  static std::uint64_t pair(const Node *left,
+                            const Node *right); // Mix of one neighbour pair
+  static std::uint64_t mix(std::uint64_t value); // 64-bit finalizer
+};
+
+template <typename T, typename Hash>
+FingerprintedLinkedList<T, Hash>::FingerprintedLinkedList() {
+  _fingerprint = pair(nullptr, nullptr); // Head sentinel next to tail sentinel
+}
+
+template <typename T, typename Hash>
+FingerprintedLinkedList<T, Hash>::FingerprintedLinkedList(
+    const FingerprintedLinkedList &list)
+    : _list(list._list), _fingerprint(list._fingerprint) {}
+
+template <typename T, typename Hash>
+FingerprintedLinkedList<T, Hash>::FingerprintedLinkedList(
+    FingerprintedLinkedList &&list)
+    : _list(std::move(list._list)), _fingerprint(list._fingerprint) {
+  list._fingerprint = pair(nullptr, nullptr);
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::PrintForward() const {
+  _list.PrintForward();
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::PrintReverse() const {
+  _list.PrintReverse();
+}
+
+template <typename T, typename Hash>
+std::uint64_t FingerprintedLinkedList<T, Hash>::Fingerprint() const {
+  return _fingerprint;
+}
+
+template <typename T, typename Hash>
+unsigned int FingerprintedLinkedList<T, Hash>::NodeCount() const {
+  return _list.NodeCount();
+}
+
+template <typename T, typename Hash>
+const typename FingerprintedLinkedList<T, Hash>::Node *
+FingerprintedLinkedList<T, Hash>::Find(const T &data) const {
+  return _list.Find(data);
+}
+
+template <typename T, typename Hash>
+const typename FingerprintedLinkedList<T, Hash>::Node *
+FingerprintedLinkedList<T, Hash>::GetNode(unsigned int index) const {
+  return _list.GetNode(index);
+}
+
+template <typename T, typename Hash>
+const typename FingerprintedLinkedList<T, Hash>::Node *
+FingerprintedLinkedList<T, Hash>::Head() const {
+  return _list.Head();
+}
+
+template <typename T, typename Hash>
+const typename FingerprintedLinkedList<T, Hash>::Node *
+FingerprintedLinkedList<T, Hash>::Tail() const {
+  return _list.Tail();
+}
+
+template <typename T, typename Hash>
+const LinkedList<T> &FingerprintedLinkedList<T, Hash>::List() const {
+  return _list;
+}
+
+template <typename T, typename Hash>
+typename FingerprintedLinkedList<T, Hash>::const_iterator
+FingerprintedLinkedList<T, Hash>::begin() const {
+  return _list.begin();
+}
+
+template <typename T, typename Hash>
+typename FingerprintedLinkedList<T, Hash>::const_iterator
+FingerprintedLinkedList<T, Hash>::end() const {
+  return _list.end();
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::AddHead(const T &data) {
+  linked(_list.EmplaceHead(data));
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::AddTail(const T &data) {
+  linked(_list.EmplaceTail(data));
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::AddNodesHead(const T *data,
+                                                    unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddHead(data[count - i - 1]); // To preserve the order of the array, start
+                                  // by adding the nth element and counting down
+  }
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::AddNodesTail(const T *data,
+                                                    unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddTail(data[i]);
+  }
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::InsertAfter(const Node *node,
+                                                   const T &data) {
+  linked(_list.EmplaceAfter(const_cast<Node *>(node), data));
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::InsertBefore(const Node *node,
+                                                    const T &data) {
+  linked(_list.EmplaceBefore(const_cast<Node *>(node), data));
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::InsertAt(const T &data,
+                                                unsigned int index) {
+  if (index > _list.NodeCount()) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _list.NodeCount()) {
+    AddTail(data);
+  } else {
+    InsertBefore(_list.GetNode(index), data);
+  }
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::Set(const Node *node, const T &data) {
+  unlinking(node);
+  const_cast<Node *>(node)->data = data;
+  linked(node);
+}
+
+template <typename T, typename Hash>
+bool FingerprintedLinkedList<T, Hash>::RemoveHead() {
+  if (_list.Head() == nullptr) {
+    return false;
+  }
+  unlinking(_list.Head());
+  return _list.RemoveHead();
+}
+
+template <typename T, typename Hash>
+bool FingerprintedLinkedList<T, Hash>::RemoveTail() {
+  if (_list.Tail() == nullptr) {
+    return false;
+  }
+  unlinking(_list.Tail());
+  return _list.RemoveTail();
+}
+
+template <typename T, typename Hash>
+unsigned int FingerprintedLinkedList<T, Hash>::Remove(const T &data) {
+  const T value = data; // data may live in one of the nodes being removed
+  unsigned int removed = 0;
+  Node *current_node = _list.Head();
+  while (current_node != nullptr) {
+    Node *next = current_node->next;
+    if (current_node->data == value) {
+      RemoveNode(current_node);
+      removed++;
+    }
+    current_node = next;
+  }
+  return removed;
+}
+
+template <typename T, typename Hash>
+bool FingerprintedLinkedList<T, Hash>::RemoveAt(unsigned int index) {
+  if (index >= _list.NodeCount()) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  RemoveNode(_list.GetNode(index));
+  return true;
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::RemoveNode(const Node *node) {
+  unlinking(node);
+  _list.RemoveNode(const_cast<Node *>(node));
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::Clear() {
+  _list.Clear();
+  _fingerprint = pair(nullptr, nullptr);
+}
+
+template <typename T, typename Hash>
+const T &
+FingerprintedLinkedList<T, Hash>::operator[](unsigned int index) const {
+  return _list[index];
+}
+
+template <typename T, typename Hash>
+bool FingerprintedLinkedList<T, Hash>::operator==(
+    const FingerprintedLinkedList &rhs) const {
+  if (_fingerprint != rhs._fingerprint ||
+      _list.NodeCount() != rhs._list.NodeCount()) {
+    return false;
+  }
+  return _list == rhs._list; // Fingerprints agree; confirm element by element
+}
+
+template <typename T, typename Hash>
+bool FingerprintedLinkedList<T, Hash>::operator!=(
+    const FingerprintedLinkedList &rhs) const {
+  return !(*this == rhs);
+}
+
+template <typename T, typename Hash>
+FingerprintedLinkedList<T, Hash> &FingerprintedLinkedList<T, Hash>::operator=(
+    const FingerprintedLinkedList &rhs) {
+  _list = rhs._list;
+  _fingerprint = rhs._fingerprint;
+  return *this;
+}
+
+template <typename T, typename Hash>
+FingerprintedLinkedList<T, Hash> &
+FingerprintedLinkedList<T, Hash>::operator=(FingerprintedLinkedList &&rhs) {
+  if (this != &rhs) {
+    _list = std::move(rhs._list);
+    _fingerprint = rhs._fingerprint;
+    rhs._fingerprint = pair(nullptr, nullptr);
+  }
+  return *this;
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::linked(const Node *node) {
+  // node now sits between prev and next, splitting their former pair
+  _fingerprint -= pair(node->prev, node->next);
+  _fingerprint += pair(node->prev, node) + pair(node, node->next);
+}
+
+template <typename T, typename Hash>
+void FingerprintedLinkedList<T, Hash>::unlinking(const Node *node) {
+  _fingerprint -= pair(node->prev, node) + pair(node, node->next);
+  _fingerprint += pair(node->prev, node->next);
+}
+
+template <typename T, typename Hash>
+std::uint64_t FingerprintedLinkedList<T, Hash>::pair(const Node *left,
+                                                     const Node *right) {
+  const std::uint64_t head_sentinel = 0x243F6A8885A308D3ull;
+  const std::uint64_t tail_sentinel = 0x13198A2E03707344ull;
+  std::uint64_t lhs =
+      left == nullptr ? head_sentinel : mix(Hash()(left->data));
+  std::uint64_t rhs =
+      right == nullptr ? tail_sentinel : mix(Hash()(right->data) + 1);
+  // Different multipliers on each side make the mix order-sensitive
+  return mix(lhs * 0x9E3779B97F4A7C15ull + rhs * 0xC2B2AE3D27D4EB4Full);
+}
+
+template <typename T, typename Hash>
+std::uint64_t FingerprintedLinkedList<T, Hash>::mix(std::uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ull;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBull;
+  value ^= value >> 31;
+  return value;
+}
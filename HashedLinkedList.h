@@ -0,0 +1,384 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "LinkedList.h"
+
+// LinkedList with a value -> node hash index. Every insertion and removal path
+// (including Clear, copy and assignment) keeps the index in sync, so Find,
+// Contains and Count are O(1) on average and Remove(value) costs O(k) in the
+// number of matches. Nodes holding equal values share one index entry with a
+// set of those nodes, so dropping a single node is O(1) on average however
+// many duplicates it has. Each key references the data stored inside one of
+// its nodes, so no element is copied into the index.
+//
+// Elements are only reachable read-only; use Set() to change a stored value so
+// that the index follows the change. When several nodes hold equal values,
+// Find returns one of them, not necessarily the first in list order.
+template <typename T, typename Hash = std::hash<T>,
+          typename KeyEqual = std::equal_to<T>>
+class HashedLinkedList {
+public:
+  using Node = typename LinkedList<T>::Node;
+  using const_iterator = typename LinkedList<T>::const_iterator;
+
+  // Construction / destruction
+  HashedLinkedList();                             // Default constructor
+  HashedLinkedList(const HashedLinkedList &list); // Copy constructor
+  HashedLinkedList(HashedLinkedList &&list) noexcept; // Move constructor
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+
+  // Accessors
+  unsigned int NodeCount() const; // Returns number of nodes
+  void FindAll(std::vector<const Node *> &outData, const T &value)
+      const; // Appends every node containing value, in no particular order
+  const Node *Find(const T &data) const; // A node containing data, O(1)
+  bool Contains(const T &data) const;    // Whether any node holds data, O(1)
+  unsigned int Count(const T &data) const; // Number of nodes holding data
+  const Node *GetNode(unsigned int index) const; // Returns the nth node
+  const Node *Head() const;                      // Returns first node
+  const Node *Tail() const;                      // Returns last node
+  const LinkedList<T> &List() const; // Underlying list for read-only use
+  const_iterator begin() const;      // Iterator to first node
+  const_iterator end() const;        // Iterator past last node
+
+  // Insertion
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void AddNodesHead(const T *data,
+                    unsigned int count); // Given array, link nodes at front
+  void AddNodesTail(const T *data,
+                    unsigned int count); // Given array, link nodes at end
+  void InsertAfter(const Node *node,
+                   const T &data); // Insert node after specified node
+  void InsertBefore(const Node *node,
+                    const T &data); // Insert node before specified node
+  void InsertAt(const T &data,
+                unsigned int index); // Insert node at given index
+
+  // Modification
+  void Set(const Node *node, const T &data); // Replace a node's value
+
+  // Removal
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all nodes containing data
+  bool RemoveAt(unsigned int index);  // Delete node at index
+  void RemoveNode(const Node *node);  // Delete specified node
+  void Clear();                       // Delete all nodes in list
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  bool operator==(const HashedLinkedList &rhs) const; // Equality operator
+  HashedLinkedList &
+  operator=(const HashedLinkedList &rhs); // Copy assignment operator
+  HashedLinkedList &
+  operator=(HashedLinkedList &&rhs) noexcept; // Move assignment operator
+
+private:
+  using Key = std::reference_wrapper<const T>; // Refers to a node's data
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const { return Hash()(key.get()); }
+  };
+  struct KeyEqualTo {
+    bool operator()(const Key &lhs, const Key &rhs) const {
+      return KeyEqual()(lhs.get(), rhs.get());
+    }
+  };
+  using Group = std::unordered_set<Node *>; // Every node holding one value
+  using Index = std::unordered_map<Key, Group, KeyHash, KeyEqualTo>;
+
+  // Member variables
+  LinkedList<T> _list; // Nodes in list order
+  Index _index;        // Value -> every node holding that value
+
+  // Private behaviors
+  void index_node(Node *node);   // Add node's entry to the index
+  void unindex_node(Node *node); // Drop node's entry from the index
+  void rebuild_index();          // Re-index every node of _list
+};
+
+template <typename T, typename Hash, typename KeyEqual>
+HashedLinkedList<T, Hash, KeyEqual>::HashedLinkedList() {}
+
+template <typename T, typename Hash, typename KeyEqual>
+HashedLinkedList<T, Hash, KeyEqual>::HashedLinkedList(
+    const HashedLinkedList &list)
+    : _list(list._list) {
+  rebuild_index();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+HashedLinkedList<T, Hash, KeyEqual>::HashedLinkedList(
+    HashedLinkedList &&list) noexcept
+    : _list(std::move(list._list)), _index(std::move(list._index)) {
+  list._index.clear(); // Nodes moved with _list, so the keys stay valid here
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::PrintForward() const {
+  _list.PrintForward();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::PrintReverse() const {
+  _list.PrintReverse();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+unsigned int HashedLinkedList<T, Hash, KeyEqual>::NodeCount() const {
+  return _list.NodeCount();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::FindAll(
+    std::vector<const Node *> &outData, const T &value) const {
+  auto entry = _index.find(std::cref(value));
+  if (entry != _index.end()) {
+    outData.insert(outData.end(), entry->second.begin(), entry->second.end());
+  }
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const typename HashedLinkedList<T, Hash, KeyEqual>::Node *
+HashedLinkedList<T, Hash, KeyEqual>::Find(const T &data) const {
+  auto entry = _index.find(std::cref(data));
+  return entry == _index.end() ? nullptr : *entry->second.begin();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool HashedLinkedList<T, Hash, KeyEqual>::Contains(const T &data) const {
+  return _index.find(std::cref(data)) != _index.end();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+unsigned int HashedLinkedList<T, Hash, KeyEqual>::Count(const T &data) const {
+  auto entry = _index.find(std::cref(data));
+  return entry == _index.end() ? 0 : entry->second.size();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const typename HashedLinkedList<T, Hash, KeyEqual>::Node *
+HashedLinkedList<T, Hash, KeyEqual>::GetNode(unsigned int index) const {
+  return _list.GetNode(index);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const typename HashedLinkedList<T, Hash, KeyEqual>::Node *
+HashedLinkedList<T, Hash, KeyEqual>::Head() const {
+  return _list.Head();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const typename HashedLinkedList<T, Hash, KeyEqual>::Node *
+HashedLinkedList<T, Hash, KeyEqual>::Tail() const {
+  return _list.Tail();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const LinkedList<T> &HashedLinkedList<T, Hash, KeyEqual>::List() const {
+  return _list;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+typename HashedLinkedList<T, Hash, KeyEqual>::const_iterator
+HashedLinkedList<T, Hash, KeyEqual>::begin() const {
+  return _list.begin();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+typename HashedLinkedList<T, Hash, KeyEqual>::const_iterator
+HashedLinkedList<T, Hash, KeyEqual>::end() const {
+  return _list.end();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::AddHead(const T &data) {
+  index_node(_list.EmplaceHead(data));
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::AddTail(const T &data) {
+  index_node(_list.EmplaceTail(data));
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::AddNodesHead(const T *data,
+                                                      unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddHead(data[count - i - 1]); // To preserve the order of the array, start
+                                  // by adding the nth element and counting down
+  }
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::AddNodesTail(const T *data,
+                                                      unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddTail(data[i]);
+  }
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::InsertAfter(const Node *node,
+                                                     const T &data) {
+  index_node(_list.EmplaceAfter(const_cast<Node *>(node), data));
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::InsertBefore(const Node *node,
+                                                      const T &data) {
+  index_node(_list.EmplaceBefore(const_cast<Node *>(node), data));
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::InsertAt(const T &data,
+                                                  unsigned int index) {
+  if (index > _list.NodeCount()) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _list.NodeCount()) {
+    AddTail(data);
+  } else {
+    InsertBefore(_list.GetNode(index), data);
+  }
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::Set(const Node *node,
+                                             const T &data) {
+  Node *target = const_cast<Node *>(node);
+  unindex_node(target);
+  target->data = data;
+  index_node(target);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool HashedLinkedList<T, Hash, KeyEqual>::RemoveHead() {
+  if (_list.Head() == nullptr) {
+    return false;
+  }
+  unindex_node(_list.Head());
+  return _list.RemoveHead();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool HashedLinkedList<T, Hash, KeyEqual>::RemoveTail() {
+  if (_list.Tail() == nullptr) {
+    return false;
+  }
+  unindex_node(_list.Tail());
+  return _list.RemoveTail();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+unsigned int HashedLinkedList<T, Hash, KeyEqual>::Remove(const T &data) {
+  auto entry = _index.find(std::cref(data));
+  if (entry == _index.end()) {
+    return 0;
+  }
+  // Take the whole group out first: its key refers to one of these nodes
+  Group group = std::move(_index.extract(entry).mapped());
+  for (Node *node : group) {
+    _list.RemoveNode(node);
+  }
+  return group.size();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool HashedLinkedList<T, Hash, KeyEqual>::RemoveAt(unsigned int index) {
+  if (index >= _list.NodeCount()) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  RemoveNode(_list.GetNode(index));
+  return true;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::RemoveNode(const Node *node) {
+  Node *target = const_cast<Node *>(node);
+  unindex_node(target);
+  _list.RemoveNode(target);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::Clear() {
+  _index.clear();
+  _list.Clear();
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+const T &
+HashedLinkedList<T, Hash, KeyEqual>::operator[](unsigned int index) const {
+  return _list[index];
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool HashedLinkedList<T, Hash, KeyEqual>::operator==(
+    const HashedLinkedList &rhs) const {
+  return _list == rhs._list;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+HashedLinkedList<T, Hash, KeyEqual> &
+HashedLinkedList<T, Hash, KeyEqual>::operator=(const HashedLinkedList &rhs) {
+  if (this != &rhs) {
+    _index.clear(); // Keys point into nodes that the copy is about to free
+    _list = rhs._list;
+    rebuild_index();
+  }
+  return *this;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+HashedLinkedList<T, Hash, KeyEqual> &
+HashedLinkedList<T, Hash, KeyEqual>::operator=(
+    HashedLinkedList &&rhs) noexcept {
+  if (this != &rhs) {
+    _index = std::move(rhs._index);
+    _list = std::move(rhs._list);
+    rhs._index.clear();
+  }
+  return *this;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::index_node(Node *node) {
+  _index.try_emplace(std::cref(node->data)).first->second.insert(node);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::unindex_node(Node *node) {
+  auto entry = _index.find(std::cref(node->data));
+  if (entry == _index.end()) {
+    return;
+  }
+  Group &group = entry->second;
+  group.erase(node);
+  if (group.empty()) {
+    _index.erase(entry);
+  } else if (&entry->first.get() == &node->data) {
+    // The key refers to this node's data; point it at a node that stays
+    auto handle = _index.extract(entry);
+    handle.key() = std::cref((*handle.mapped().begin())->data);
+    _index.insert(std::move(handle));
+  }
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void HashedLinkedList<T, Hash, KeyEqual>::rebuild_index() {
+  _index.clear();
+  _index.reserve(_list.NodeCount());
+  for (Node *node = _list.Head(); node != nullptr; node = node->next) {
+    index_node(node);
+  }
+}
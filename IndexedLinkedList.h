@@ -0,0 +1,558 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Doubly-linked list with an order-statistic index. Every node is also a node
+// of a treap keyed by list position (an implicit treap) that stores the size
+// of its subtree, so GetNode, operator[], InsertAt and RemoveAt run in
+// expected O(log n) instead of walking from _head. The next/prev threading is
+// kept alongside the tree, so the familiar LinkedList API and node walking
+// still work unchanged.
+template <typename T> class IndexedLinkedList {
+public:
+  struct Node; // Declaration of nested Node struct
+
+  // Construction / destruction
+  IndexedLinkedList();                                  // Default constructor
+  IndexedLinkedList(const IndexedLinkedList &list);     // Copy constructor
+  IndexedLinkedList(IndexedLinkedList &&list) noexcept; // Move constructor
+  ~IndexedLinkedList();                                 // Destructor
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+
+  // Accessors
+  unsigned int NodeCount() const; // Returns _size
+  void FindAll(std::vector<Node *> &outData, const T &value)
+      const; // Returns a vector with all nodes containing value
+  const Node *Find(
+      const T &data) const; // Returns pointer to first node with specified data
+  Node *
+  Find(const T &data); // Returns pointer to first node with specified data
+  const Node *
+  GetNode(unsigned int index) const; // Returns the nth node in O(log n)
+  Node *GetNode(unsigned int index); // Returns the nth node in O(log n)
+  unsigned int IndexOf(const Node *node) const; // Position of node, O(log n)
+  Node *Head();                                 // Returns _head
+  const Node *Head() const;                     // Returns _head
+  Node *Tail();                                 // Returns _tail
+  const Node *Tail() const;                     // Returns _tail
+
+  // Insertion
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void AddNodesHead(const T *data,
+                    unsigned int count); // Given array, link nodes at front
+  void AddNodesTail(const T *data,
+                    unsigned int count); // Given array, link nodes at end
+  void InsertAfter(Node *node,
+                   const T &data); // Insert node after specified node
+  void InsertBefore(Node *node,
+                    const T &data); // Insert node before specified node
+  void InsertAt(const T &data,
+                unsigned int index); // Insert node at given index
+
+  // Removal
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all nodes containing data
+  bool RemoveAt(unsigned int index);  // Delete node at index
+  void RemoveNode(Node *node);        // Delete specified node
+  void Clear();                       // Delete all nodes in list
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  T &operator[](unsigned int index);             // Subscript operator
+  bool operator==(const IndexedLinkedList &rhs) const; // Equality operator
+  IndexedLinkedList &
+  operator=(const IndexedLinkedList &rhs); // Copy assignment operator
+  IndexedLinkedList &
+  operator=(IndexedLinkedList &&rhs) noexcept; // Move assignment operator
+
+private:
+  // Member variables
+  Node *_head;            // Pointer to first node in linked list
+  Node *_tail;            // Pointer to last node in linked list
+  Node *_root;            // Root of the positional treap
+  unsigned int _size;     // Number of nodes in linked list
+  unsigned int _priority; // State of the priority generator
+
+  // Private behaviors
+  Node *select(unsigned int index) const; // Walk the treap down to index
+  Node *create_node(const T &data);       // Allocate node with fresh priority
+  void attach_leaf(Node *parent, Node *leaf,
+                   bool left); // Hang leaf under parent and restore heap order
+  void rotate_up(Node *node);  // Rotate node above its parent
+  static unsigned int subtree_size(const Node *node); // 0 for nullptr
+};
+
+// Nested Node struct for IndexedLinkedList class
+template <typename T> struct IndexedLinkedList<T>::Node {
+  T data;     // Data stored in the node
+  Node *next; // Pointer to next node in linked list
+  Node *prev; // Pointer to previous node in linked list
+
+  // Constructors
+  Node(const T &data); // Constructor with data assignment
+
+private:
+  friend class IndexedLinkedList<T>;
+
+  Node *parent;          // Treap parent; nullptr for _root
+  Node *left;            // Treap child holding earlier positions
+  Node *right;           // Treap child holding later positions
+  unsigned int size;     // Number of nodes in this subtree
+  unsigned int priority; // Heap priority; smaller values sit closer to _root
+};
+
+template <typename T>
+IndexedLinkedList<T>::Node::Node(const T &data) : data(data) {
+  next = nullptr;
+  prev = nullptr;
+  parent = nullptr;
+  left = nullptr;
+  right = nullptr;
+  size = 1;
+  priority = 0;
+}
+
+template <typename T> IndexedLinkedList<T>::IndexedLinkedList() {
+  _head = nullptr;
+  _tail = nullptr;
+  _root = nullptr;
+  _size = 0;
+  _priority = 2463534242u;
+}
+
+template <typename T>
+IndexedLinkedList<T>::IndexedLinkedList(const IndexedLinkedList &list)
+    : IndexedLinkedList() {
+  for (const Node *node = list._head; node != nullptr; node = node->next) {
+    AddTail(node->data);
+  }
+}
+
+template <typename T>
+IndexedLinkedList<T>::IndexedLinkedList(IndexedLinkedList &&list) noexcept
+    : IndexedLinkedList() {
+  *this = std::move(list);
+}
+
+template <typename T> IndexedLinkedList<T>::~IndexedLinkedList() { Clear(); }
+
+template <typename T> void IndexedLinkedList<T>::PrintForward() const {
+  for (const Node *node = _head; node != nullptr; node = node->next) {
+    std::cout << node->data << std::endl;
+  }
+}
+
+template <typename T> void IndexedLinkedList<T>::PrintReverse() const {
+  for (const Node *node = _tail; node != nullptr; node = node->prev) {
+    std::cout << node->data << std::endl;
+  }
+}
+
+template <typename T> unsigned int IndexedLinkedList<T>::NodeCount() const {
+  return _size;
+}
+
+template <typename T>
+void IndexedLinkedList<T>::FindAll(std::vector<Node *> &outData,
+                                   const T &value) const {
+  for (Node *node = _head; node != nullptr; node = node->next) {
+    if (node->data == value) {
+      outData.push_back(node);
+    }
+  }
+}
+
+template <typename T>
+const typename IndexedLinkedList<T>::Node *
+IndexedLinkedList<T>::Find(const T &data) const {
+  Node *node = _head;
+  while (node != nullptr && !(node->data == data)) {
+    node = node->next;
+  }
+  return node;
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *IndexedLinkedList<T>::Find(const T &data) {
+  Node *node = _head;
+  while (node != nullptr && !(node->data == data)) {
+    node = node->next;
+  }
+  return node;
+}
+
+template <typename T>
+const typename IndexedLinkedList<T>::Node *
+IndexedLinkedList<T>::GetNode(unsigned int index) const {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  return select(index);
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *
+IndexedLinkedList<T>::GetNode(unsigned int index) {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  return select(index);
+}
+
+template <typename T>
+unsigned int IndexedLinkedList<T>::IndexOf(const Node *node) const {
+  // Everything in node's left subtree comes first, plus every ancestor (and
+  // its left subtree) that node sits to the right of
+  unsigned int index = subtree_size(node->left);
+  while (node->parent != nullptr) {
+    if (node == node->parent->right) {
+      index += subtree_size(node->parent->left) + 1;
+    }
+    node = node->parent;
+  }
+  return index;
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *IndexedLinkedList<T>::Head() {
+  return _head;
+}
+
+template <typename T>
+const typename IndexedLinkedList<T>::Node *IndexedLinkedList<T>::Head() const {
+  return _head;
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *IndexedLinkedList<T>::Tail() {
+  return _tail;
+}
+
+template <typename T>
+const typename IndexedLinkedList<T>::Node *IndexedLinkedList<T>::Tail() const {
+  return _tail;
+}
+
+template <typename T> void IndexedLinkedList<T>::AddHead(const T &data) {
+  Node *new_head = create_node(data);
+  if (_head == nullptr) {
+    _root = new_head;
+    _head = new_head;
+    _tail = new_head;
+    _size = 1;
+    return;
+  }
+  new_head->next = _head;
+  _head->prev = new_head;
+  Node *old_head = _head;
+  _head = new_head;
+  attach_leaf(old_head, new_head, true); // _head never has a left child
+}
+
+template <typename T> void IndexedLinkedList<T>::AddTail(const T &data) {
+  Node *new_tail = create_node(data);
+  if (_tail == nullptr) {
+    _root = new_tail;
+    _head = new_tail;
+    _tail = new_tail;
+    _size = 1;
+    return;
+  }
+  new_tail->prev = _tail;
+  _tail->next = new_tail;
+  Node *old_tail = _tail;
+  _tail = new_tail;
+  attach_leaf(old_tail, new_tail, false); // _tail never has a right child
+}
+
+template <typename T>
+void IndexedLinkedList<T>::AddNodesHead(const T *data, unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddHead(data[count - i - 1]); // To preserve the order of the array, start
+                                  // by adding the nth element and counting down
+  }
+}
+
+template <typename T>
+void IndexedLinkedList<T>::AddNodesTail(const T *data, unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddTail(data[i]);
+  }
+}
+
+template <typename T>
+void IndexedLinkedList<T>::InsertAfter(Node *node, const T &data) {
+  if (node == _tail) {
+    AddTail(data);
+    return;
+  }
+  InsertBefore(node->next, data);
+}
+
+template <typename T>
+void IndexedLinkedList<T>::InsertBefore(Node *node, const T &data) {
+  if (node == _head) {
+    AddHead(data);
+    return;
+  }
+  Node *new_node = create_node(data);
+  new_node->next = node;
+  new_node->prev = node->prev;
+  node->prev->next = new_node;
+  node->prev = new_node;
+
+  // The in-order slot right before node is either node's empty left child or
+  // the empty right child of its in-order predecessor
+  if (node->left == nullptr) {
+    attach_leaf(node, new_node, true);
+  } else {
+    attach_leaf(new_node->prev, new_node, false);
+  }
+}
+
+template <typename T>
+void IndexedLinkedList<T>::InsertAt(const T &data, unsigned int index) {
+  if (index > _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _size) {
+    AddTail(data);
+  } else {
+    InsertBefore(select(index), data);
+  }
+}
+
+template <typename T> bool IndexedLinkedList<T>::RemoveHead() {
+  if (_head == nullptr) {
+    return false;
+  }
+  RemoveNode(_head);
+  return true;
+}
+
+template <typename T> bool IndexedLinkedList<T>::RemoveTail() {
+  if (_tail == nullptr) {
+    return false;
+  }
+  RemoveNode(_tail);
+  return true;
+}
+
+template <typename T>
+unsigned int IndexedLinkedList<T>::Remove(const T &data) {
+  unsigned int removed = 0;
+  Node *owner = nullptr; // Matching node that data itself lives in, if any
+  Node *node = _head;
+  while (node != nullptr) {
+    Node *next = node->next;
+    if (node->data == data) {
+      if (&node->data == &data) {
+        owner = node; // Freed last, so data stays valid during the scan
+      } else {
+        RemoveNode(node);
+      }
+      removed++;
+    }
+    node = next;
+  }
+  if (owner != nullptr) {
+    RemoveNode(owner);
+  }
+  return removed;
+}
+
+template <typename T> bool IndexedLinkedList<T>::RemoveAt(unsigned int index) {
+  if (index >= _size) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  RemoveNode(select(index));
+  return true;
+}
+
+template <typename T> void IndexedLinkedList<T>::RemoveNode(Node *node) {
+  // Rotate node down until it is a leaf, then cut it off
+  while (node->left != nullptr || node->right != nullptr) {
+    if (node->right == nullptr ||
+        (node->left != nullptr &&
+         node->left->priority < node->right->priority)) {
+      rotate_up(node->left);
+    } else {
+      rotate_up(node->right);
+    }
+  }
+  if (node->parent == nullptr) {
+    _root = nullptr;
+  } else if (node->parent->left == node) {
+    node->parent->left = nullptr;
+  } else {
+    node->parent->right = nullptr;
+  }
+  for (Node *ancestor = node->parent; ancestor != nullptr;
+       ancestor = ancestor->parent) {
+    ancestor->size--;
+  }
+
+  if (node->prev != nullptr) {
+    node->prev->next = node->next;
+  } else {
+    _head = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  } else {
+    _tail = node->prev;
+  }
+  delete node;
+  _size--;
+}
+
+template <typename T> void IndexedLinkedList<T>::Clear() {
+  Node *node = _head;
+  while (node != nullptr) {
+    Node *next = node->next;
+    delete node;
+    node = next;
+  }
+  _head = nullptr;
+  _tail = nullptr;
+  _root = nullptr;
+  _size = 0;
+}
+
+template <typename T>
+const T &IndexedLinkedList<T>::operator[](unsigned int index) const {
+  return GetNode(index)->data;
+}
+
+template <typename T> T &IndexedLinkedList<T>::operator[](unsigned int index) {
+  return GetNode(index)->data;
+}
+
+template <typename T>
+bool IndexedLinkedList<T>::operator==(const IndexedLinkedList &rhs) const {
+  if (_size != rhs._size) {
+    return false;
+  }
+  const Node *rhs_node = rhs._head;
+  for (const Node *lhs_node = _head; lhs_node != nullptr;
+       lhs_node = lhs_node->next) {
+    if (lhs_node->data != rhs_node->data) {
+      return false;
+    }
+    rhs_node = rhs_node->next;
+  }
+  return true;
+}
+
+template <typename T>
+IndexedLinkedList<T> &
+IndexedLinkedList<T>::operator=(const IndexedLinkedList &rhs) {
+  if (this != &rhs) {
+    Clear();
+    for (const Node *node = rhs._head; node != nullptr; node = node->next) {
+      AddTail(node->data);
+    }
+  }
+  return *this;
+}
+
+template <typename T>
+IndexedLinkedList<T> &
+IndexedLinkedList<T>::operator=(IndexedLinkedList &&rhs) noexcept {
+  if (this != &rhs) {
+    Clear();
+    std::swap(_head, rhs._head);
+    std::swap(_tail, rhs._tail);
+    std::swap(_root, rhs._root);
+    std::swap(_size, rhs._size);
+  }
+  return *this;
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *
+IndexedLinkedList<T>::select(unsigned int index) const {
+  Node *node = _root;
+  while (true) {
+    unsigned int left_size = subtree_size(node->left);
+    if (index < left_size) {
+      node = node->left;
+    } else if (index == left_size) {
+      return node;
+    } else {
+      index -= left_size + 1;
+      node = node->right;
+    }
+  }
+}
+
+template <typename T>
+typename IndexedLinkedList<T>::Node *
+IndexedLinkedList<T>::create_node(const T &data) {
+  Node *node = new Node(data);
+  _priority ^= _priority << 13; // xorshift32
+  _priority ^= _priority >> 17;
+  _priority ^= _priority << 5;
+  node->priority = _priority;
+  return node;
+}
+
+template <typename T>
+void IndexedLinkedList<T>::attach_leaf(Node *parent, Node *leaf, bool left) {
+  if (left) {
+    parent->left = leaf;
+  } else {
+    parent->right = leaf;
+  }
+  leaf->parent = parent;
+  for (Node *ancestor = parent; ancestor != nullptr;
+       ancestor = ancestor->parent) {
+    ancestor->size++;
+  }
+  while (leaf->parent != nullptr && leaf->priority < leaf->parent->priority) {
+    rotate_up(leaf);
+  }
+  _size++;
+}
+
+template <typename T> void IndexedLinkedList<T>::rotate_up(Node *node) {
+  Node *parent = node->parent;
+  Node *grandparent = parent->parent;
+  if (node == parent->left) {
+    parent->left = node->right;
+    if (node->right != nullptr) {
+      node->right->parent = parent;
+    }
+    node->right = parent;
+  } else {
+    parent->right = node->left;
+    if (node->left != nullptr) {
+      node->left->parent = parent;
+    }
+    node->left = parent;
+  }
+  parent->parent = node;
+  node->parent = grandparent;
+  if (grandparent == nullptr) {
+    _root = node;
+  } else if (grandparent->left == parent) {
+    grandparent->left = node;
+  } else {
+    grandparent->right = node;
+  }
+  parent->size = subtree_size(parent->left) + subtree_size(parent->right) + 1;
+  node->size = subtree_size(node->left) + subtree_size(node->right) + 1;
+}
+
+template <typename T>
+unsigned int IndexedLinkedList<T>::subtree_size(const Node *node) {
+  return node == nullptr ? 0 : node->size;
+}
@@ -0,0 +1,471 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+// Links embedded in an object so it can sit in an IntrusiveLinkedList
+template <typename T> struct IntrusiveListHook {
+  T *next = nullptr; // Next object in the list
+  T *prev = nullptr; // Previous object in the list
+};
+
+// Doubly-linked list whose prev/next links live inside the elements
+// themselves (in the IntrusiveListHook member named by Hook). The list never
+// allocates, copies or frees an element: objects stay owned by whoever created
+// them, inserting and removing only rewires pointers, and an object can be
+// removed in O(1) given nothing but its own address. An object may be in at
+// most one list per hook at a time; give it several hooks to be in several.
+//
+// Removal never throws: RemoveHead, RemoveTail and RemoveAt return nullptr when
+// there is nothing to remove (RemoveAt also reports the bad index on cerr, as
+// LinkedList::RemoveAt does). Remove(object) requires object to be in this
+// list. Debug builds assert the O(1) part of that: object's neighbours link
+// back to it, and an end without a neighbour is this list's _head or _tail.
+// An interior object of another list passes that check; define
+// INTRUSIVE_LINKED_LIST_FULL_CHECKS to assert IsLinked instead, which walks to
+// the front of object's chain on every removal.
+template <typename T, IntrusiveListHook<T> T::*Hook = &T::hook>
+class IntrusiveLinkedList {
+public:
+  template <bool IsConst>
+  class Iterator; // Declaration of nested bidirectional iterator
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  // Construction / destruction
+  IntrusiveLinkedList(); // Default constructor
+  IntrusiveLinkedList(const IntrusiveLinkedList &) = delete;
+  IntrusiveLinkedList &operator=(const IntrusiveLinkedList &) = delete;
+  IntrusiveLinkedList(IntrusiveLinkedList &&list) noexcept; // Move constructor
+  IntrusiveLinkedList &
+  operator=(IntrusiveLinkedList &&list) noexcept; // Move assignment operator
+  ~IntrusiveLinkedList(); // Unlinks (but does not destroy) every element
+
+  // Behaviors
+  void PrintForward() const; // Print all linked list items in order
+  void PrintReverse() const; // Print all linked list items in reverse
+
+  // Accessors
+  unsigned int NodeCount() const; // Returns _size
+  const T *Find(const T &value) const; // First element equal to value
+  T *Find(const T &value);             // First element equal to value
+  template <typename Predicate>
+  T *FindIf(Predicate pred); // First element for which pred is true
+  T *GetNode(unsigned int index); // Returns the nth element
+  T *Head();                      // Returns _head
+  const T *Head() const;          // Returns _head
+  T *Tail();                      // Returns _tail
+  const T *Tail() const;          // Returns _tail
+  static T *Next(const T &object); // Element after object, or nullptr
+  static T *Prev(const T &object); // Element before object, or nullptr
+  bool IsLinked(const T &object) const; // Whether object is in this list;
+                                        // O(1) at either end, else walks
+                                        // back to the front
+
+  // Iteration
+  iterator begin();             // Iterator to _head
+  iterator end();               // Iterator past _tail
+  const_iterator begin() const; // Iterator to _head
+  const_iterator end() const;   // Iterator past _tail
+
+  // Insertion (never allocates)
+  void AddHead(T &object); // Link object at front of list
+  void AddTail(T &object); // Link object at end of list
+  void InsertAfter(T &position, T &object);  // Link object after position
+  void InsertBefore(T &position, T &object); // Link object before position
+  void InsertAt(T &object, unsigned int index); // Link object at index
+
+  // Removal (never frees)
+  T *RemoveHead();              // Unlink and return head, nullptr if empty
+  T *RemoveTail();              // Unlink and return tail, nullptr if empty
+  void Remove(T &object);       // Unlink object in O(1); must be in this list
+  T *RemoveAt(unsigned int index); // Unlink and return element at index,
+                                   // nullptr if index is out of range
+  void Clear();                 // Unlink every element
+
+private:
+  // Member variables
+  T *_head;           // First element in list
+  T *_tail;           // Last element in list
+  unsigned int _size; // Number of elements in list
+
+  static IntrusiveListHook<T> &hook(T &object);
+  static const IntrusiveListHook<T> &hook(const T &object);
+  bool links_back(const T &object) const; // Neighbours (or _head/_tail) point
+                                          // at object; O(1)
+};
+
+// Nested bidirectional iterator for IntrusiveLinkedList class
+template <typename T, IntrusiveListHook<T> T::*Hook>
+template <bool IsConst>
+class IntrusiveLinkedList<T, Hook>::Iterator {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<IsConst, const T *, T *>::type;
+  using reference = typename std::conditional<IsConst, const T &, T &>::type;
+  using list_pointer = const IntrusiveLinkedList *;
+
+  Iterator() : _object(nullptr), _list(nullptr) {}
+  Iterator(pointer object, list_pointer list) : _object(object), _list(list) {}
+
+  reference operator*() const { return *_object; }
+  pointer operator->() const { return _object; }
+
+  Iterator &operator++() {
+    _object = hook(*_object).next;
+    return *this;
+  }
+  Iterator operator++(int) {
+    Iterator previous = *this;
+    ++*this;
+    return previous;
+  }
+  Iterator &operator--() {
+    _object = _object == nullptr ? _list->_tail : hook(*_object).prev;
+    return *this;
+  }
+  Iterator operator--(int) {
+    Iterator previous = *this;
+    --*this;
+    return previous;
+  }
+
+  friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._object == rhs._object;
+  }
+  friend bool operator!=(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._object != rhs._object;
+  }
+
+private:
+  pointer _object;    // Current element; nullptr once past _tail
+  list_pointer _list; // Owning list, used to step back from end()
+};
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+IntrusiveLinkedList<T, Hook>::IntrusiveLinkedList() {
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+IntrusiveLinkedList<T, Hook>::IntrusiveLinkedList(
+    IntrusiveLinkedList &&list) noexcept {
+  _head = list._head;
+  _tail = list._tail;
+  _size = list._size;
+  list._head = nullptr;
+  list._tail = nullptr;
+  list._size = 0;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+IntrusiveLinkedList<T, Hook> &
+IntrusiveLinkedList<T, Hook>::operator=(IntrusiveLinkedList &&list) noexcept {
+  if (this != &list) {
+    Clear();
+    _head = list._head;
+    _tail = list._tail;
+    _size = list._size;
+    list._head = nullptr;
+    list._tail = nullptr;
+    list._size = 0;
+  }
+  return *this;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+IntrusiveLinkedList<T, Hook>::~IntrusiveLinkedList() {
+  Clear();
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::PrintForward() const {
+  for (const T *object = _head; object != nullptr;
+       object = hook(*object).next) {
+    std::cout << *object << std::endl;
+  }
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::PrintReverse() const {
+  for (const T *object = _tail; object != nullptr;
+       object = hook(*object).prev) {
+    std::cout << *object << std::endl;
+  }
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+unsigned int IntrusiveLinkedList<T, Hook>::NodeCount() const {
+  return _size;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+const T *IntrusiveLinkedList<T, Hook>::Find(const T &value) const {
+  const T *object = _head;
+  while (object != nullptr && !(*object == value)) {
+    object = hook(*object).next;
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::Find(const T &value) {
+  T *object = _head;
+  while (object != nullptr && !(*object == value)) {
+    object = hook(*object).next;
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+template <typename Predicate>
+T *IntrusiveLinkedList<T, Hook>::FindIf(Predicate pred) {
+  T *object = _head;
+  while (object != nullptr && !pred(static_cast<const T &>(*object))) {
+    object = hook(*object).next;
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::GetNode(unsigned int index) {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  T *object = _head;
+  for (unsigned int i = 0; i < index; i++) {
+    object = hook(*object).next;
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::Head() {
+  return _head;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+const T *IntrusiveLinkedList<T, Hook>::Head() const {
+  return _head;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::Tail() {
+  return _tail;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+const T *IntrusiveLinkedList<T, Hook>::Tail() const {
+  return _tail;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::Next(const T &object) {
+  return hook(object).next;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::Prev(const T &object) {
+  return hook(object).prev;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+bool IntrusiveLinkedList<T, Hook>::IsLinked(const T &object) const {
+  // Another list may use the same hook, so a non-null link alone proves
+  // nothing; follow the chain to its first element and compare with _head
+  if (&object == _head || &object == _tail) {
+    return true;
+  }
+  if (hook(object).next == nullptr) {
+    return false; // Unlinked, or the tail of some other list
+  }
+  const T *first = &object;
+  while (hook(*first).prev != nullptr) {
+    first = hook(*first).prev;
+  }
+  return first == _head;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+typename IntrusiveLinkedList<T, Hook>::iterator
+IntrusiveLinkedList<T, Hook>::begin() {
+  return iterator(_head, this);
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+typename IntrusiveLinkedList<T, Hook>::iterator
+IntrusiveLinkedList<T, Hook>::end() {
+  return iterator(nullptr, this);
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+typename IntrusiveLinkedList<T, Hook>::const_iterator
+IntrusiveLinkedList<T, Hook>::begin() const {
+  return const_iterator(_head, this);
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+typename IntrusiveLinkedList<T, Hook>::const_iterator
+IntrusiveLinkedList<T, Hook>::end() const {
+  return const_iterator(nullptr, this);
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::AddHead(T &object) {
+  hook(object).prev = nullptr;
+  hook(object).next = _head;
+  if (_head == nullptr) {
+    _tail = &object;
+  } else {
+    hook(*_head).prev = &object;
+  }
+  _head = &object;
+  _size++;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::AddTail(T &object) {
+  hook(object).next = nullptr;
+  hook(object).prev = _tail;
+  if (_tail == nullptr) {
+    _head = &object;
+  } else {
+    hook(*_tail).next = &object;
+  }
+  _tail = &object;
+  _size++;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::InsertAfter(T &position, T &object) {
+  if (&position == _tail) {
+    AddTail(object);
+    return;
+  }
+  T *next = hook(position).next;
+  hook(object).prev = &position;
+  hook(object).next = next;
+  hook(*next).prev = &object;
+  hook(position).next = &object;
+  _size++;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::InsertBefore(T &position, T &object) {
+  if (&position == _head) {
+    AddHead(object);
+    return;
+  }
+  T *prev = hook(position).prev;
+  hook(object).next = &position;
+  hook(object).prev = prev;
+  hook(*prev).next = &object;
+  hook(position).prev = &object;
+  _size++;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::InsertAt(T &object, unsigned int index) {
+  if (index > _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _size) {
+    AddTail(object);
+  } else {
+    InsertBefore(*GetNode(index), object);
+  }
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::RemoveHead() {
+  T *object = _head;
+  if (object != nullptr) {
+    Remove(*object);
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::RemoveTail() {
+  T *object = _tail;
+  if (object != nullptr) {
+    Remove(*object);
+  }
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::Remove(T &object) {
+#ifdef INTRUSIVE_LINKED_LIST_FULL_CHECKS
+  assert(IsLinked(object) && "Remove: object is not in this list");
+#else
+  assert(links_back(object) && "Remove: object is not in this list");
+#endif
+  IntrusiveListHook<T> &links = hook(object);
+  if (links.prev != nullptr) {
+    hook(*links.prev).next = links.next;
+  } else {
+    _head = links.next;
+  }
+  if (links.next != nullptr) {
+    hook(*links.next).prev = links.prev;
+  } else {
+    _tail = links.prev;
+  }
+  links.prev = nullptr;
+  links.next = nullptr;
+  _size--;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+T *IntrusiveLinkedList<T, Hook>::RemoveAt(unsigned int index) {
+  if (index >= _size) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return nullptr;
+  }
+  T *object = GetNode(index);
+  Remove(*object);
+  return object;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+void IntrusiveLinkedList<T, Hook>::Clear() {
+  T *object = _head;
+  while (object != nullptr) {
+    T *next = hook(*object).next;
+    hook(*object).prev = nullptr; // Leave every hook ready for reuse
+    hook(*object).next = nullptr;
+    object = next;
+  }
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+IntrusiveListHook<T> &IntrusiveLinkedList<T, Hook>::hook(T &object) {
+  return object.*Hook;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+const IntrusiveListHook<T> &
+IntrusiveLinkedList<T, Hook>::hook(const T &object) {
+  return object.*Hook;
+}
+
+template <typename T, IntrusiveListHook<T> T::*Hook>
+bool IntrusiveLinkedList<T, Hook>::links_back(const T &object) const {
+  const IntrusiveListHook<T> &links = hook(object);
+  bool front = links.prev == nullptr ? _head == &object
+                                     : hook(*links.prev).next == &object;
+  bool back = links.next == nullptr ? _tail == &object
+                                    : hook(*links.next).prev == &object;
+  return front && back;
+}
@@ -1,27 +1,89 @@
 #pragma once
 
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <locale>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "NodePool.h"
+#include "NodeReclaimer.h"
+
 using std::cout;
 using std::endl;
 using std::vector;
 
-// Doubly-linked list
-template <typename T> class LinkedList {
+// Hint that the memory at address is about to be read; a no-op where the
+// compiler has no prefetch builtin
+inline void linked_list_prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+// Result of LinkedList::Compact. bytes_reclaimed comes from the allocator's
+// trim() and is only ever non-zero for PoolAllocator (or another allocator
+// with a trim() member); with std::allocator freed nodes go straight back to
+// the heap and it is always 0.
+struct LinkedListCompactStats {
+  std::size_t bytes_reclaimed;     // Empty pool blocks returned to the heap
+  std::size_t page_switches_saved; // Fewer 4 KiB page changes along a walk
+};
+
+// Doubly-linked list. Nodes are obtained from Allocator (rebound to Node), so
+// passing a PoolAllocator<T> from NodePool.h recycles nodes through a slab pool
+//
+// With a NodeReclaimer set, Clear(), the destructor and bulk removals detach
+// the nodes in O(1) and leave freeing them to the reclaimer's thread. The
+// reclaimer must outlive the list's last release. Only stateless allocators
+// (is_always_equal, e.g. std::allocator) are handed to the reclaimer; with a
+// stateful one such as PoolAllocator the reclaimer is ignored and nodes are
+// freed synchronously. Moving a list, by construction or assignment, carries
+// its reclaimer along with the nodes; a copy starts without one, and copy
+// assignment keeps the target's own.
+template <typename T, typename Allocator = std::allocator<T>>
+class LinkedList {
 public:
   struct Node; // Declaration of nested Node struct
+  template <bool IsConst>
+  class Iterator; // Declaration of nested bidirectional iterator
+
+  using value_type = T;
+  using size_type = unsigned int;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
   // Construction / destruction
-  LinkedList();                          // Default constructor
-  LinkedList(const LinkedList<T> &list); // Copy constructor
-  ~LinkedList();                         // Destructor
+  LinkedList();                                     // Default constructor
+  explicit LinkedList(const Allocator &alloc);      // Uses alloc for nodes
+  LinkedList(const LinkedList<T, Allocator> &list); // Copy constructor
+  LinkedList(LinkedList<T, Allocator> &&list) noexcept; // Move constructor
+  ~LinkedList();                                        // Destructor
 
   // Behaviors
   void PrintForward() const; // Print all linked list items in order
   void PrintReverse() const; // Print all linked list items in reverse
   void PrintForwardRecursive(const Node *node) const;
   void PrintReverseRecursive(const Node *node) const;
+  void WriteTo(std::ostream &out,
+               char delimiter = '\n') const; // Write items in order, one
+                                             // flush at the end
+  void WriteReverseTo(std::ostream &out,
+                      char delimiter = '\n') const; // Write items in reverse,
+                                                    // one flush at the end
 
   // Accessors
   unsigned int NodeCount() const; // Returns _size
@@ -38,51 +100,169 @@ public:
   const Node *Head() const;          // Returns _head
   Node *Tail();                      // Returns _tail
   const Node *Tail() const;          // Returns _tail
+  Allocator GetAllocator() const;    // Returns copy of the list's allocator
+  void SetReclaimer(NodeReclaimer *reclaimer); // Defer node release to
+                                               // reclaimer (nullptr = free
+                                               // synchronously)
+
+  // Iteration
+  iterator begin();                         // Iterator to _head
+  const_iterator begin() const;             // Iterator to _head
+  const_iterator cbegin() const;            // Iterator to _head
+  iterator end();                           // Iterator past _tail
+  const_iterator end() const;               // Iterator past _tail
+  const_iterator cend() const;              // Iterator past _tail
+  reverse_iterator rbegin();                // Reverse iterator to _tail
+  const_reverse_iterator rbegin() const;    // Reverse iterator to _tail
+  const_reverse_iterator crbegin() const;   // Reverse iterator to _tail
+  reverse_iterator rend();                  // Reverse iterator before _head
+  const_reverse_iterator rend() const;      // Reverse iterator before _head
+  const_reverse_iterator crend() const;     // Reverse iterator before _head
+  iterator IteratorTo(Node *node);          // Iterator positioned at node
+  const_iterator IteratorTo(const Node *node) const; // Iterator at node
 
   // Insertion
   void AddHead(const T &data); // Create new node at front of list
+  void AddHead(T &&data);      // Create new node at front of list
   void AddTail(const T &data); // Create new node at end of list
+  void AddTail(T &&data);      // Create new node at end of list
   void
   AddNodesHead(const T *data,
                unsigned int count); // Given array, progressively link nodes
   void AddNodesTail(const T *data,
                     unsigned int count); // Given array, regressively link nodes
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void AddNodesHead(InputIt first,
+                    InputIt last); // Link a range in order at front of list
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void AddNodesTail(InputIt first,
+                    InputIt last); // Link a range in order at end of list
+  void AddNodesHead(std::initializer_list<T> data); // Link values at front
+  void AddNodesTail(std::initializer_list<T> data); // Link values at end
   void InsertAfter(Node *node,
                    const T &data); // Insert node after specified node
+  void InsertAfter(Node *node, T &&data); // Insert node after specified node
   void InsertBefore(Node *node,
                     const T &data); // Insert node before specified node
+  void InsertBefore(Node *node, T &&data); // Insert node before specified node
   void InsertAt(const T &data,
                 unsigned int index); // Insert node at given index
+  void InsertAt(T &&data, unsigned int index); // Insert node at given index
+  template <typename... Args>
+  Node *EmplaceHead(Args &&...args); // Construct T in a new node at front
+  template <typename... Args>
+  Node *EmplaceTail(Args &&...args); // Construct T in a new node at end
+  template <typename... Args>
+  Node *EmplaceAfter(Node *node,
+                     Args &&...args); // Construct T in a node after node
+  template <typename... Args>
+  Node *EmplaceBefore(Node *node,
+                      Args &&...args); // Construct T in a node before node
 
   // Removal
   bool RemoveHead();                  // Delete current head from list
   bool RemoveTail();                  // Delete current list from list
   unsigned int Remove(const T &data); // Delete all nodes containing data
+  template <typename Predicate>
+  unsigned int RemoveIf(Predicate pred); // Delete all nodes matching pred
   bool RemoveAt(unsigned int index);  // Delete node at index
+  void RemoveNode(Node *node);        // Delete specified node
   void Clear();                       // Delete all nodes in list
 
+  // Relinking (no allocation or payload copies when allocators compare equal)
+  void Splice(Node *position,
+              LinkedList<T, Allocator> &other); // Move all of other before
+                                                // position (nullptr = end)
+  void Splice(Node *position, LinkedList<T, Allocator> &other,
+              Node *node); // Move node out of other before position
+  void Splice(Node *position, LinkedList<T, Allocator> &other, Node *first,
+              Node *last); // Move other's nodes first..last (inclusive)
+  LinkedList<T, Allocator>
+  SplitAfter(Node *node); // Detach every node after node into a new list
+  void Append(LinkedList<T, Allocator> &&other); // Move all of other to end
+  LinkedListCompactStats
+  Compact(bool trim = true); // Move nodes into traversal order in fresh
+                             // memory; invalidates Node pointers
+
+  // Ordering (stable, relinks existing nodes without allocating)
+  void Sort(); // Bottom-up merge sort using operator<
+  template <typename Compare> void Sort(Compare comp); // Sort using comp
+  void Merge(LinkedList<T, Allocator> &&other); // Merge sorted other into list
+  template <typename Compare>
+  void Merge(LinkedList<T, Allocator> &&other,
+             Compare comp);          // Merge sorted other using comp
+  Node *InsertSorted(const T &data); // Insert after any equal nodes
+  template <typename Compare>
+  Node *InsertSorted(const T &data,
+                     Compare comp); // Insert in order defined by comp
+
   // Operators
   const T &operator[](unsigned int index) const;   // Subscript operator
   T &operator[](unsigned int index);               // Subscript operator
-  bool operator==(const LinkedList<T> &rhs) const; // Equality operator
-  LinkedList<T> &
-  operator=(const LinkedList<T> &rhs); // Copy assignment operator
+  bool operator==(
+      const LinkedList<T, Allocator> &rhs) const; // Equality operator
+  LinkedList<T, Allocator> &
+  operator=(const LinkedList<T, Allocator> &rhs); // Copy assignment operator
+  LinkedList<T, Allocator> &
+  operator=(LinkedList<T, Allocator> &&rhs); // Move assignment operator
 
 private:
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>; // Allocator rebound to Node
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
   // Member variables
-  Node *_head;        // Pointer to first node in linked list
-  Node *_tail;        // Pointer to last node in linked list
-  unsigned int _size; // Number of nodes in linked list
+  Node *_head;          // Pointer to first node in linked list
+  Node *_tail;          // Pointer to last node in linked list
+  unsigned int _size;   // Number of nodes in linked list
+  NodeAllocator _alloc; // Source of every node in the list
+  NodeReclaimer *_reclaimer; // Where detached chains are released, if set
 
   // Private behaviors
+  template <typename... Args>
+  Node *create_node(Args &&...args); // Allocate and construct a detached node
+  void destroy_node(Node *node);     // Destruct and release a single node
+  void link_head(Node *node);        // Link a detached node at front of list
+  void link_tail(Node *node);        // Link a detached node at end of list
+  void link_after(Node *node, Node *new_node);  // Link new_node after node
+  void link_before(Node *node, Node *new_node); // Link new_node before node
+  void link_chain(Node *position, Node *first, Node *last,
+                  unsigned int count); // Link detached first..last before
+                                       // position (nullptr = end)
+  void unlink_chain(Node *first, Node *last,
+                    unsigned int count); // Detach first..last from the list
+  void adopt_next_chain(Node *first); // Make first.. (next links only) the
+                                      // list; rebuild prev links and _tail
+  template <typename InputIt>
+  void add_range(Node *position, InputIt first,
+                 InputIt last); // Build a detached chain, then link it once
+  template <typename InputIt>
+  void add_range(Node *position, InputIt first, InputIt last,
+                 unsigned int expected); // As above; reserve expected
+                                         // nodes first (0 = unknown)
+  void reserve_nodes(unsigned int count); // Let a pooling allocator pre-carve
+                                          // one block for count nodes
+  unsigned int
+  traversal_page_switches() const; // Page changes along the list, plus 1
+  void free_nodes(); // Release every node without touching _head/_tail/_size
+  void free_chain(Node *first); // Release a detached, null-terminated chain
+  static void release_chain(NodeAllocator &alloc,
+                            Node *first); // Free a chain on this thread
   void copy_from_object(
-      const LinkedList<T>
+      const LinkedList<T, Allocator>
           &object); // Helper function for copy assignment and copy constructor
-  void remove_node(Node *node); // Helper function for Remove and RemoveAAt
+  void remove_node(Node *node); // Helper function for RemoveNode and RemoveAt
+  Node *find_node(const T &data) const; // Two-cursor search behind Find
+  Node *node_at(unsigned int index) const; // Walk from the nearer end
+  void write_chain(std::ostream &out, const Node *node, bool forward,
+                   char delimiter) const; // Write node onwards, no recursion
 };
 
 // Nested Node struct for LinkedList class
-template <typename T> struct LinkedList<T>::Node {
+template <typename T, typename Allocator>
+struct LinkedList<T, Allocator>::Node {
   T data;     // Data stored in the node
   Node *next; // Pointer to next node in linked list
   Node *prev; // Pointer to previous node in linked list
@@ -90,152 +270,258 @@ template <typename T> struct LinkedList<T>::Node {
   // Constructors
   Node();              // Default constructor
   Node(const T &data); // Constructor with data assignment
+  template <typename... Args>
+  Node(std::in_place_t,
+       Args &&...args); // Construct data in place from args
+};
+
+// Nested bidirectional iterator for LinkedList class. The end() iterator holds
+// a null node, so it keeps a pointer to its list to be able to step back onto
+// _tail.
+template <typename T, typename Allocator>
+template <bool IsConst>
+class LinkedList<T, Allocator>::Iterator {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<IsConst, const T *, T *>::type;
+  using reference = typename std::conditional<IsConst, const T &, T &>::type;
+  using node_pointer =
+      typename std::conditional<IsConst, const Node *, Node *>::type;
+  using list_pointer = const LinkedList<T, Allocator> *;
+
+  Iterator() : _node(nullptr), _list(nullptr) {}
+  Iterator(node_pointer node, list_pointer list) : _node(node), _list(list) {}
+  template <bool WasConst, typename = typename std::enable_if<IsConst &&
+                                                              !WasConst>::type>
+  Iterator(const Iterator<WasConst> &other) // iterator -> const_iterator
+      : _node(other.GetNode()), _list(other.GetList()) {}
+
+  reference operator*() const { return _node->data; }
+  pointer operator->() const { return &_node->data; }
+  node_pointer GetNode() const { return _node; } // Node the iterator is at
+  list_pointer GetList() const { return _list; } // List being traversed
+
+  Iterator &operator++() {
+    _node = _node->next;
+    return *this;
+  }
+  Iterator operator++(int) {
+    Iterator previous = *this;
+    _node = _node->next;
+    return previous;
+  }
+  Iterator &operator--() {
+    _node = _node == nullptr ? _list->_tail : _node->prev;
+    return *this;
+  }
+  Iterator operator--(int) {
+    Iterator previous = *this;
+    --*this;
+    return previous;
+  }
+
+  friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._node == rhs._node;
+  }
+  friend bool operator!=(const Iterator &lhs, const Iterator &rhs) {
+    return lhs._node != rhs._node;
+  }
+
+private:
+  node_pointer _node; // Current node; nullptr once past _tail
+  list_pointer _list; // Owning list, used to step back from end()
 };
 
-template <typename T> LinkedList<T>::LinkedList() {
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList() {
   _head = nullptr;
   _tail = nullptr;
   _size = 0;
+  _reclaimer = nullptr;
 }
 
-template <typename T> LinkedList<T>::LinkedList(const LinkedList<T> &list) {
-  copy_from_object(list);
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(const Allocator &alloc) : _alloc(alloc) {
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _reclaimer = nullptr;
 }
 
-template <typename T> LinkedList<T>::~LinkedList() {
-  Node *current_node = _head;
-  while (current_node != nullptr) // next member variable of last pointer in a
-                                  // linked list should always be null
-  {
-    Node *next =
-        current_node
-            ->next; // Summon the next node before deallocating the current node
-    delete current_node;
-    current_node = next;
-  }
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(const LinkedList<T, Allocator> &list)
+    : _alloc(NodeTraits::select_on_container_copy_construction(list._alloc)) {
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _reclaimer = nullptr;
+  copy_from_object(list); // Empty destination, so every node comes from one
+                          // batched chain
 }
 
-template <typename T> void LinkedList<T>::PrintForward() const {
-  Node *current_node =
-      _head; // Use pointer to quickly iterate through list items
-  for (unsigned int item = 0; item < _size; item++) {
-    cout << current_node->data << endl;
-    current_node =
-        current_node
-            ->next; // Set the current node to the previous node for next loop
-  }
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(LinkedList<T, Allocator> &&list) noexcept
+    : _alloc(list._alloc) {
+  _head = list._head; // Steal the chain; no node is touched
+  _tail = list._tail;
+  _size = list._size;
+  _reclaimer = list._reclaimer; // The teardown policy travels with the nodes
+  list._head = nullptr;
+  list._tail = nullptr;
+  list._size = 0;
 }
 
-template <typename T> void LinkedList<T>::PrintReverse() const {
-  Node *current_node =
-      _tail; // Use pointer to quickly iterate through list items
-  for (unsigned int item = 0; item < _size; item++) {
-    cout << current_node->data << endl;
-    current_node =
-        current_node
-            ->prev; // Set the current node to the previous node for next loop
-  }
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::~LinkedList() {
+  free_nodes();
 }
 
-template <typename T>
-void LinkedList<T>::PrintForwardRecursive(const Node *node) const {
-  if (node != nullptr) {
-    cout << node->data << endl;
-    node = node->next;
-    PrintForwardRecursive(node);
-  }
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::PrintForward() const {
+  WriteTo(cout); // Same output as one endl per item, flushed once
 }
 
-template <typename T>
-void LinkedList<T>::PrintReverseRecursive(const Node *node) const {
-  if (node != nullptr) {
-    cout << node->data << endl;
-    node = node->prev;
-    PrintReverseRecursive(node);
-  }
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::PrintReverse() const {
+  WriteReverseTo(cout);
 }
 
-template <typename T> void LinkedList<T>::AddHead(const T &data) {
-  Node *new_head = new Node(data); // New node to be added to front of list
-  if (_head == nullptr)            // Check to see if list is empty
-  {
-    // If list was previously empty, list now has a size of 1 and thus _head and
-    // _tail are the same node
-    _head = new_head;
-    _tail = new_head;
-    _size = 1;
-  } else {
-    _head->prev = new_head; // Inform node currently at front of list that a new
-                            // node will be inserted in front of it
-    new_head->next = _head; // Set new_head to point to current front of list
-    _head = new_head;       // Set list to begin with new_head
-    new_head->prev = nullptr; // Since new_head is now at front of list, nothing
-                              // comes before it
-    _size++;                  // Increment size of linked list
-  }
+// Kept for compatibility; walks the list iteratively so long lists cannot
+// overflow the stack
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::PrintForwardRecursive(const Node *node) const {
+  write_chain(cout, node, true, '\n');
 }
 
-template <typename T> void LinkedList<T>::AddTail(const T &data) {
-  Node *new_tail = new Node(data); // New node to be added at end of list
-  if (_head == nullptr)            // Check to see if list is empty
-  {
-    // If list was previously empty, list now has a size of 1 and thus _tail and
-    // _head are the same node
-    _tail = new_tail;
-    _head = new_tail;
-    _size = 1;
-  } else {
-    _tail->next = new_tail;   // Inform node currently at end of list that a new
-                              // node will be inserted behind it
-    new_tail->prev = _tail;   // Set new_tail to point to current end of list
-    _tail = new_tail;         // Set list to end with new_tail
-    new_tail->next = nullptr; // Since new_tail is now at end of list, nothing
-                              // comes before it
-    _size++;                  // Increment size of linked list
-  }
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::PrintReverseRecursive(const Node *node) const {
+  write_chain(cout, node, false, '\n');
 }
 
-template <typename T>
-void LinkedList<T>::AddNodesHead(const T *data, unsigned int count) {
-  for (unsigned int i = 0; i < count; i++) {
-    AddHead(data[count - i - 1]); // To preserve the order of the array, start
-                                  // by adding the nth element and counting down
-  }
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::WriteTo(std::ostream &out,
+                                       char delimiter) const {
+  write_chain(out, _head, true, delimiter);
 }
 
-template <typename T>
-void LinkedList<T>::AddNodesTail(const T *data, unsigned int count) {
-  for (unsigned int i = 0; i < count; i++) {
-    AddTail(data[i]);
-  }
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::WriteReverseTo(std::ostream &out,
+                                              char delimiter) const {
+  write_chain(out, _tail, false, delimiter);
 }
 
-template <typename T>
-void LinkedList<T>::InsertAfter(Node *node, const T &data) {
-  Node *new_node = new Node(data); // Create node with passed in data
-  new_node->prev = node;       // Inform new_node that node will be behind it
-  new_node->next = node->next; // Inform new_node that it should point to node
-                               // in front of node
-  node->next->prev =
-      new_node; // Inform node in front of node that new_node will be behind it
-  node->next = new_node; // Inform node that new_node is now ahead of it
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddHead(const T &data) {
+  link_head(create_node(data)); // New node to be added to front of list
+}
 
-  _size++; // Increment size
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddHead(T &&data) {
+  link_head(create_node(std::move(data)));
 }
 
-template <typename T>
-void LinkedList<T>::InsertBefore(Node *node, const T &data) {
-  Node *new_node = new Node(data); // See similar comments for InsertAfter()
-  new_node->next = node;
-  new_node->prev = node->prev;
-  node->prev->next = new_node;
-  node->prev = new_node;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddTail(const T &data) {
+  link_tail(create_node(data)); // New node to be added at end of list
+}
 
-  _size++;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddTail(T &&data) {
+  link_tail(create_node(std::move(data)));
 }
 
-template <typename T>
-void LinkedList<T>::InsertAt(const T &data, unsigned int index) {
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddNodesHead(const T *data, unsigned int count) {
+  add_range(_head, data, data + count); // Chain keeps the array's order
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddNodesTail(const T *data, unsigned int count) {
+  add_range(nullptr, data, data + count);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt, typename>
+void LinkedList<T, Allocator>::AddNodesHead(InputIt first, InputIt last) {
+  add_range(_head, first, last);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt, typename>
+void LinkedList<T, Allocator>::AddNodesTail(InputIt first, InputIt last) {
+  add_range(nullptr, first, last);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddNodesHead(std::initializer_list<T> data) {
+  add_range(_head, data.begin(), data.end());
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::AddNodesTail(std::initializer_list<T> data) {
+  add_range(nullptr, data.begin(), data.end());
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertAfter(Node *node, const T &data) {
+  link_after(node, create_node(data)); // Create node with passed in data
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertAfter(Node *node, T &&data) {
+  link_after(node, create_node(std::move(data)));
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertBefore(Node *node, const T &data) {
+  link_before(node, create_node(data));
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertBefore(Node *node, T &&data) {
+  link_before(node, create_node(std::move(data)));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::EmplaceHead(Args &&...args) {
+  Node *new_head = create_node(std::forward<Args>(args)...);
+  link_head(new_head);
+  return new_head;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::EmplaceTail(Args &&...args) {
+  Node *new_tail = create_node(std::forward<Args>(args)...);
+  link_tail(new_tail);
+  return new_tail;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::EmplaceAfter(Node *node, Args &&...args) {
+  Node *new_node = create_node(std::forward<Args>(args)...);
+  link_after(node, new_node);
+  return new_node;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::EmplaceBefore(Node *node, Args &&...args) {
+  Node *new_node = create_node(std::forward<Args>(args)...);
+  link_before(node, new_node);
+  return new_node;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertAt(const T &data, unsigned int index) {
   if (index > _size or index < 0) {
     throw std::out_of_range("Error: Index out of range.");
   } else if (index == 0) {
@@ -248,20 +534,35 @@ void LinkedList<T>::InsertAt(const T &data, unsigned int index) {
   }
 }
 
-template <typename T> bool LinkedList<T>::RemoveHead() {
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::InsertAt(T &&data, unsigned int index) {
+  if (index > _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == 0) {
+    AddHead(std::move(data));
+  } else if (index == _size) {
+    AddTail(std::move(data));
+  } else {
+    Node *node = GetNode(index);
+    InsertBefore(node, std::move(data));
+  }
+}
+
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::RemoveHead() {
   if (_head == nullptr) // Check to see if list is empty
   {
     return false;
   } else if (_head->next ==
              nullptr) // Check to see if list only contains one node
   {
-    delete _head;
+    destroy_node(_head);
     _head = nullptr;
     _tail = nullptr;
   } else {
     Node *new_head = _head->next;
     new_head->prev = nullptr;
-    delete _head;
+    destroy_node(_head);
     _head = new_head; // After deleting current head, assign new head
   }
   _size--; // Decrement size
@@ -269,20 +570,21 @@ template <typename T> bool LinkedList<T>::RemoveHead() {
   return true;
 }
 
-template <typename T> bool LinkedList<T>::RemoveTail() {
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::RemoveTail() {
   if (_tail == nullptr) // See similar function RemoveHead()
   {
     return false;
   } else if (_tail->prev == nullptr) {
 
-    delete _tail;
+    destroy_node(_tail);
     _head = nullptr;
     _tail = nullptr;
   } else {
     Node *new_tail = _tail->prev;
     new_tail->next = nullptr;
 
-    delete _tail;
+    destroy_node(_tail);
     _tail = new_tail;
   }
   _size--;
@@ -290,32 +592,60 @@ template <typename T> bool LinkedList<T>::RemoveTail() {
   return true;
 }
 
-template <typename T> unsigned int LinkedList<T>::Remove(const T &data) {
-  vector<LinkedList<T>::Node *> nodes;
-  FindAll(nodes, data); // Find all nodes containing said data
+template <typename T, typename Allocator>
+unsigned int LinkedList<T, Allocator>::Remove(const T &data) {
+  return RemoveIf([&data](const T &value) { return value == data; });
+}
 
-  for (unsigned int node = 0; node < nodes.size();
-       node++) // Remove node according to its location in list
-  {
-    Node *current_node = nodes[node];
-    if (current_node->prev == nullptr) {
-      RemoveHead();
-    } else if (current_node->next == nullptr) {
-      RemoveTail();
-    } else {
-      remove_node(current_node);
+template <typename T, typename Allocator>
+template <typename Predicate>
+unsigned int LinkedList<T, Allocator>::RemoveIf(Predicate pred) {
+  // Matches are unlinked in a single pass and parked on a detached chain, so
+  // nothing is freed until the scan is over (data passed to Remove may live
+  // in one of the matching nodes) and the whole batch is released at once
+  Node *removed_head = nullptr;
+  Node *removed_tail = nullptr;
+  unsigned int removed = 0;
+
+  Node *current_node = _head;
+  while (current_node != nullptr) {
+    Node *next = current_node->next;
+    if (pred(static_cast<const T &>(current_node->data))) {
+      if (current_node->prev != nullptr) {
+        current_node->prev->next = next;
+      } else {
+        _head = next;
+      }
+      if (next != nullptr) {
+        next->prev = current_node->prev;
+      } else {
+        _tail = current_node->prev;
+      }
+
+      current_node->next = nullptr;
+      if (removed_tail == nullptr) {
+        removed_head = current_node;
+      } else {
+        removed_tail->next = current_node;
+      }
+      removed_tail = current_node;
+      removed++;
     }
+    current_node = next;
   }
-  return nodes.size();
+
+  _size -= removed;
+  free_chain(removed_head);
+  return removed;
 }
 
-template <typename T>
-bool LinkedList<T>::RemoveAt(
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::RemoveAt(
     unsigned int index) // Remove node based on its index
 {
   try {
     Node *node = GetNode(index);
-    remove_node(node);
+    RemoveNode(node); // Also handles the head and tail nodes
     return true;
   } catch (const std::exception &e) {
     std::cerr << e.what() << '\n';
@@ -323,210 +653,977 @@ bool LinkedList<T>::RemoveAt(
   }
 }
 
-template <typename T> void LinkedList<T>::Clear() {
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::RemoveNode(Node *node) {
+  if (node->prev == nullptr) {
+    RemoveHead();
+  } else if (node->next == nullptr) {
+    RemoveTail();
+  } else {
+    remove_node(node);
+  }
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Clear() {
   _size = 0;
-  this->~LinkedList();
+  free_nodes();
   _head = nullptr;
   _tail = nullptr;
 }
 
-template <typename T> unsigned int LinkedList<T>::NodeCount() const {
-  return _size;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Splice(Node *position,
+                                      LinkedList<T, Allocator> &other) {
+  if (other._head == nullptr || &other == this) {
+    return;
+  }
+  Splice(position, other, other._head, other._tail);
 }
 
-// Find nodes based on data stored in node
-template <typename T>
-void LinkedList<T>::FindAll(vector<Node *> &outData, const T &value) const {
-  Node *current_node = _head;
-  for (unsigned int node_num = 0; node_num < _size; node_num++) {
-    T node_data = current_node->data;
-    if (node_data == value) {
-      outData.push_back(current_node);
-    }
-    current_node = current_node->next;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Splice(Node *position,
+                                      LinkedList<T, Allocator> &other,
+                                      Node *node) {
+  if (node == position || (&other == this && node->next == position)) {
+    return; // Already in place
   }
+  Splice(position, other, node, node);
 }
 
-// Find the first node based on data stored in node
-template <typename T>
-const typename LinkedList<T>::Node *LinkedList<T>::Find(const T &data) const {
-  Node *current_node = _head;
-  while (current_node != nullptr) {
-    if (current_node->data == data) {
-      return current_node;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Splice(Node *position,
+                                      LinkedList<T, Allocator> &other,
+                                      Node *first, Node *last) {
+  if (!(_alloc == other._alloc)) {
+    // other's nodes can't be released by our allocator; move the payloads
+    Node *stop = last->next;
+    Node *current_node = first;
+    while (current_node != stop) {
+      Node *next = current_node->next;
+      if (position == nullptr) {
+        EmplaceTail(std::move(current_node->data));
+      } else {
+        EmplaceBefore(position, std::move(current_node->data));
+      }
+      other.RemoveNode(current_node);
+      current_node = next;
     }
-    current_node = current_node->next;
+    return;
   }
-  return current_node;
+
+  unsigned int count = 0; // Size is unchanged when relinking within one list
+  if (&other != this) {
+    if (first == other._head && last == other._tail) {
+      count = other._size;
+    } else {
+      for (Node *node = first; node != last; node = node->next) {
+        count++; // Partial ranges have to be measured to keep _size right
+      }
+      count++;
+    }
+  }
+  other.unlink_chain(first, last, count);
+  link_chain(position, first, last, count);
 }
 
-template <typename T>
-typename LinkedList<T>::Node *LinkedList<T>::Find(const T &data) {
-  Node *current_node = _head;
-  while (current_node != nullptr) {
-    if (current_node->data == data) {
-      return current_node;
+template <typename T, typename Allocator>
+LinkedList<T, Allocator> LinkedList<T, Allocator>::SplitAfter(Node *node) {
+  // Same allocator a copy would get, so an allocator tied to this object
+  // (such as an inline arena) is not shared; Splice then moves payloads
+  LinkedList<T, Allocator> rest{
+      Allocator(NodeTraits::select_on_container_copy_construction(_alloc))};
+  if (node->next != nullptr) {
+    rest.Splice(nullptr, *this, node->next, _tail);
+  }
+  return rest;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Append(LinkedList<T, Allocator> &&other) {
+  Splice(nullptr, other);
+}
+
+template <typename Allocator>
+auto linked_list_reserve_contiguous(Allocator &alloc, unsigned int count, int)
+    -> decltype(alloc.reserve_contiguous(count), void()) {
+  alloc.reserve_contiguous(count);
+}
+
+template <typename Allocator>
+void linked_list_reserve_contiguous(Allocator &, unsigned int, long) {}
+
+template <typename Allocator>
+auto linked_list_trim(Allocator &alloc, int) -> decltype(alloc.trim()) {
+  return alloc.trim();
+}
+
+template <typename Allocator> std::size_t linked_list_trim(Allocator &, long) {
+  return 0;
+}
+
+template <typename T, typename Allocator>
+LinkedListCompactStats LinkedList<T, Allocator>::Compact(bool trim) {
+  unsigned int switches_before = traversal_page_switches();
+
+  // With a pooling allocator, the replacements come from one fresh block in
+  // address order; otherwise they are simply allocated back to back
+  linked_list_reserve_contiguous(_alloc, _size, 0);
+
+  // Replace nodes front to back. Old nodes are parked on a detached chain
+  // rather than freed, so their slots cannot be handed straight back out
+  // ahead of the fresh ones. If an allocation throws, the list is still whole
+  // (partly compacted) and its contents are unchanged.
+  Node *retired = nullptr;
+  try {
+    for (Node *node = _head; node != nullptr;) {
+      Node *replacement = create_node(std::move_if_noexcept(node->data));
+      Node *next = node->next;
+      replacement->prev = node->prev;
+      replacement->next = next;
+      if (node->prev != nullptr) {
+        node->prev->next = replacement;
+      } else {
+        _head = replacement;
+      }
+      if (next != nullptr) {
+        next->prev = replacement;
+      } else {
+        _tail = replacement;
+      }
+      node->next = retired;
+      retired = node;
+      node = next;
     }
-    current_node = current_node->next;
+  } catch (...) {
+    free_chain(retired);
+    throw;
   }
-  return current_node;
+  free_chain(retired);
+
+  LinkedListCompactStats stats;
+  stats.bytes_reclaimed = trim ? linked_list_trim(_alloc, 0) : 0;
+  unsigned int switches_after = traversal_page_switches();
+  stats.page_switches_saved =
+      switches_before > switches_after ? switches_before - switches_after : 0;
+  return stats;
 }
 
-// Get a particular node based on the index of list
-template <typename T>
-const typename LinkedList<T>::Node *
-LinkedList<T>::GetNode(unsigned int index) const {
-  if (index == 0) {
-    if (_head == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Sort() {
+  Sort(std::less<T>());
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::Sort(Compare comp) {
+  if (_size < 2) {
+    return;
+  }
+
+  // Bottom-up merge sort over the next links: each pass merges neighbouring
+  // runs of length width into runs of length 2 * width, with no recursion and
+  // no scratch memory. prev links are rebuilt once at the end. If comp
+  // throws, every node is chained back into the list (in unspecified order)
+  // before the exception leaves, so nothing leaks and the links stay valid.
+  Node *list = _head;
+  for (unsigned int width = 1;; width *= 2) {
+    Node *left = list;
+    Node *merged_tail = nullptr;
+    unsigned int merges = 0;
+    list = nullptr;
+
+    while (left != nullptr) {
+      merges++;
+      Node *right = left;
+      unsigned int left_size = 0;
+      while (left_size < width && right != nullptr) {
+        left_size++;
+        right = right->next;
+      }
+      unsigned int right_size = width;
+
+      while (left_size > 0 || (right_size > 0 && right != nullptr)) {
+        bool right_first = false;
+        if (left_size > 0 && right_size > 0 && right != nullptr) {
+          try {
+            right_first = comp(right->data, left->data);
+          } catch (...) {
+            // Unmerged nodes are the rest of the left run, still chained by
+            // next, and everything from right on; hang both off the output
+            Node *left_last = left;
+            for (unsigned int i = 1; i < left_size; i++) {
+              left_last = left_last->next;
+            }
+            left_last->next = right;
+            if (merged_tail != nullptr) {
+              merged_tail->next = left;
+            } else {
+              list = left;
+            }
+            adopt_next_chain(list);
+            throw;
+          }
+        }
+
+        Node *next_node;
+        if (left_size == 0) {
+          next_node = right;
+          right = right->next;
+          right_size--;
+        } else if (!right_first) {
+          next_node = left; // Ties take from the left run to stay stable
+          left = left->next;
+          left_size--;
+        } else {
+          next_node = right;
+          right = right->next;
+          right_size--;
+        }
+
+        if (merged_tail != nullptr) {
+          merged_tail->next = next_node;
+        } else {
+          list = next_node;
+        }
+        merged_tail = next_node;
+      }
+      left = right;
+    }
+    merged_tail->next = nullptr;
+
+    if (merges <= 1) {
+      break;
     }
-    return _head;
   }
-  Node *current_node = _head;
-  for (unsigned int node = 0; node < index; node++) {
-    current_node = current_node->next;
-    if (current_node == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
+
+  adopt_next_chain(list);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::Merge(LinkedList<T, Allocator> &&other) {
+  Merge(std::move(other), std::less<T>());
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::Merge(LinkedList<T, Allocator> &&other,
+                                     Compare comp) {
+  if (&other == this) {
+    return;
+  }
+  Node *position = _head;
+  while (other._head != nullptr) {
+    // Equal elements of this list stay in front of those coming from other
+    while (position != nullptr && !comp(other._head->data, position->data)) {
+      position = position->next;
+    }
+    if (position == nullptr) {
+      Splice(nullptr, other); // Everything left in other goes to the end
+      return;
     }
+    Splice(position, other, other._head);
   }
+}
 
-  return current_node;
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::InsertSorted(const T &data) {
+  return InsertSorted(data, std::less<T>());
 }
 
-template <typename T>
-typename LinkedList<T>::Node *LinkedList<T>::GetNode(unsigned int index) {
-  if (index == 0) {
-    if (_head == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
+template <typename T, typename Allocator>
+template <typename Compare>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::InsertSorted(const T &data, Compare comp) {
+  Node *position = _head;
+  while (position != nullptr && !comp(data, position->data)) {
+    position = position->next;
+  }
+  if (position == nullptr) {
+    return EmplaceTail(data);
+  }
+  return EmplaceBefore(position, data);
+}
+
+template <typename T, typename Allocator>
+unsigned int LinkedList<T, Allocator>::NodeCount() const {
+  return _size;
+}
+
+// Find nodes based on data stored in node. One cursor walks forward from
+// _head and another backward from _tail, so two independent pointer chains are
+// in flight at once. Back-half matches wait in a small on-stack buffer until
+// the front half is done; if it fills up, the unvisited middle is finished by
+// the front cursor alone, so no call ever allocates scratch space.
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::FindAll(vector<Node *> &outData,
+                                       const T &value) const {
+  const unsigned int buffered = 64; // Back-half matches held at once
+  Node *back_matches[buffered];
+  unsigned int back_count = 0;
+  Node *front = _head;
+  Node *back = _tail;
+  unsigned int unvisited = _size;
+  for (; unvisited >= 2 && back_count < buffered; unvisited -= 2) {
+    linked_list_prefetch(front->next);
+    linked_list_prefetch(back->prev);
+    if (front->data == value) {
+      outData.push_back(front);
+    }
+    if (back->data == value) {
+      back_matches[back_count++] = back;
     }
-    return _head;
+    front = front->next;
+    back = back->prev;
   }
-  Node *current_node = _head;
-  for (unsigned int node = 0; node < index; node++) {
-    current_node = current_node->next;
-    if (current_node == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
+  for (; unvisited != 0; unvisited--) {
+    if (front->data == value) {
+      outData.push_back(front); // Middle node, or the rest after a full buffer
     }
+    front = front->next;
+  }
+  while (back_count != 0) {
+    outData.push_back(back_matches[--back_count]); // Back to list order
   }
+}
 
-  return current_node;
+// Find the first node based on data stored in node
+template <typename T, typename Allocator>
+const typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::Find(const T &data) const {
+  return find_node(data);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::Find(const T &data) {
+  return find_node(data);
+}
+
+// Get a particular node based on the index of list, walking from whichever end
+// is nearer
+template <typename T, typename Allocator>
+const typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::GetNode(unsigned int index) const {
+  return node_at(index);
 }
 
-template <typename T> typename LinkedList<T>::Node *LinkedList<T>::Head() {
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::GetNode(unsigned int index) {
+  return node_at(index);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *LinkedList<T, Allocator>::Head() {
   return _head;
 }
 
-template <typename T>
-const typename LinkedList<T>::Node *LinkedList<T>::Head() const {
+template <typename T, typename Allocator>
+const typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::Head() const {
   return _head;
 }
 
-template <typename T> typename LinkedList<T>::Node *LinkedList<T>::Tail() {
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *LinkedList<T, Allocator>::Tail() {
   return _tail;
 }
 
-template <typename T>
-const typename LinkedList<T>::Node *LinkedList<T>::Tail() const {
+template <typename T, typename Allocator>
+const typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::Tail() const {
   return _tail;
 }
 
-template <typename T>
-const T &LinkedList<T>::operator[](unsigned int index) const {
-  if (index == 0) {
-    if (_head == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
-    }
-    return _head->data;
-  }
-  Node *current_node = _head;
-  for (unsigned int node = 0; node < index; node++) {
-    current_node = current_node->next;
-    if (current_node == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
-    }
-  }
+template <typename T, typename Allocator>
+Allocator LinkedList<T, Allocator>::GetAllocator() const {
+  return Allocator(_alloc);
+}
 
-  return current_node->data;
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::SetReclaimer(NodeReclaimer *reclaimer) {
+  _reclaimer = reclaimer;
 }
 
-template <typename T> 
-T &LinkedList<T>::operator[](unsigned int index) {
-  if (index == 0) {
-    if (_head == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
-    }
-    return _head->data;
-  }
-  Node *current_node = _head;
-  for (unsigned int node = 0; node < index; node++) {
-    current_node = current_node->next;
-    if (current_node == nullptr) {
-      throw std::out_of_range("Error: Index out of range.");
-    }
-  }
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::begin() {
+  return iterator(_head, this);
+}
 
-  return current_node->data;
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_iterator
+LinkedList<T, Allocator>::begin() const {
+  return const_iterator(_head, this);
 }
 
-template <typename T>
-bool LinkedList<T>::operator==(const LinkedList<T> &rhs) const {
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_iterator
+LinkedList<T, Allocator>::cbegin() const {
+  return const_iterator(_head, this);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::end() {
+  return iterator(nullptr, this);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_iterator
+LinkedList<T, Allocator>::end() const {
+  return const_iterator(nullptr, this);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_iterator
+LinkedList<T, Allocator>::cend() const {
+  return const_iterator(nullptr, this);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::reverse_iterator
+LinkedList<T, Allocator>::rbegin() {
+  return reverse_iterator(end());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_reverse_iterator
+LinkedList<T, Allocator>::rbegin() const {
+  return const_reverse_iterator(end());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_reverse_iterator
+LinkedList<T, Allocator>::crbegin() const {
+  return const_reverse_iterator(cend());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::reverse_iterator
+LinkedList<T, Allocator>::rend() {
+  return reverse_iterator(begin());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_reverse_iterator
+LinkedList<T, Allocator>::rend() const {
+  return const_reverse_iterator(begin());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_reverse_iterator
+LinkedList<T, Allocator>::crend() const {
+  return const_reverse_iterator(cbegin());
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::iterator
+LinkedList<T, Allocator>::IteratorTo(Node *node) {
+  return iterator(node, this);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::const_iterator
+LinkedList<T, Allocator>::IteratorTo(const Node *node) const {
+  return const_iterator(node, this);
+}
+
+template <typename T, typename Allocator>
+const T &LinkedList<T, Allocator>::operator[](unsigned int index) const {
+  return node_at(index)->data; // Walks from the nearer end
+}
+
+template <typename T, typename Allocator> 
+T &LinkedList<T, Allocator>::operator[](unsigned int index) {
+  return node_at(index)->data; // Walks from the nearer end
+}
+
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::operator==(
+    const LinkedList<T, Allocator> &rhs) const {
   if (_size != rhs._size) {
     return false;
   }
 
-  Node *lhs_node = _head;
-  Node *rhs_node = rhs._head;
-  for (unsigned int node = 0; node < _size; node++) {
-    if (lhs_node->data != rhs_node->data) {
+  // Compare from both ends at once: four independent pointer chains (front and
+  // back of each list) keep several cache misses in flight
+  Node *lhs_front = _head;
+  Node *rhs_front = rhs._head;
+  Node *lhs_back = _tail;
+  Node *rhs_back = rhs._tail;
+  for (unsigned int step = 0; step < _size / 2; step++) {
+    if (lhs_front->data != rhs_front->data ||
+        lhs_back->data != rhs_back->data) {
       return false;
     }
-    lhs_node = lhs_node->next;
-    rhs_node = rhs_node->next;
+    lhs_front = lhs_front->next;
+    rhs_front = rhs_front->next;
+    lhs_back = lhs_back->prev;
+    rhs_back = rhs_back->prev;
   }
-  return true;
+  return _size % 2 == 0 || !(lhs_front->data != rhs_front->data);
 }
 
-template <typename T>
-LinkedList<T> &LinkedList<T>::operator=(const LinkedList<T> &rhs) {
-  this->~LinkedList();
+template <typename T, typename Allocator>
+LinkedList<T, Allocator> &
+LinkedList<T, Allocator>::operator=(const LinkedList<T, Allocator> &rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  if (NodeTraits::propagate_on_container_copy_assignment::value) {
+    if (!(_alloc == rhs._alloc)) {
+      Clear(); // Our nodes must go back to the allocator that made them
+    }
+    _alloc = rhs._alloc;
+  }
   copy_from_object(rhs);
 
   return *this;
 }
 
+template <typename T, typename Allocator>
+LinkedList<T, Allocator> &
+LinkedList<T, Allocator>::operator=(LinkedList<T, Allocator> &&rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  free_nodes();
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _reclaimer = rhs._reclaimer; // The teardown policy travels with the nodes
+
+  if (NodeTraits::propagate_on_container_move_assignment::value ||
+      _alloc == rhs._alloc) {
+    // rhs's nodes can be released by our allocator, so take the chain as is
+    if (NodeTraits::propagate_on_container_move_assignment::value) {
+      _alloc = rhs._alloc; // Copy, so rhs stays usable and equal
+    }
+    _head = rhs._head;
+    _tail = rhs._tail;
+    _size = rhs._size;
+    rhs._head = nullptr;
+    rhs._tail = nullptr;
+    rhs._size = 0;
+  } else {
+    // Nodes belong to a different allocator; move the payloads over instead
+    for (Node *node = rhs._head; node != nullptr; node = node->next) {
+      AddTail(std::move(node->data));
+    }
+    rhs.Clear();
+  }
+
+  return *this;
+}
+
 // Default constructor
-template <typename T> LinkedList<T>::Node::Node() {
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::Node::Node() {
   next = nullptr;
   prev = nullptr;
   data = T();
 }
 
 // Constructor with data parameter
-template <typename T> LinkedList<T>::Node::Node(const T &data) {
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::Node::Node(const T &data) : data(data) {
   next = nullptr;
   prev = nullptr;
-  this->data = data;
 }
 
-template <typename T>
-void LinkedList<T>::copy_from_object(const LinkedList<T> &object) {
-  Node *current_node = object._head;
-  T new_data = current_node->data;
-  _head = nullptr;
-  _tail = nullptr;
-  while (current_node != nullptr) {
-    new_data = current_node->data;
-    AddTail(new_data);
+// Constructor forwarding args to T's constructor
+template <typename T, typename Allocator>
+template <typename... Args>
+LinkedList<T, Allocator>::Node::Node(std::in_place_t, Args &&...args)
+    : data(std::forward<Args>(args)...) {
+  next = nullptr;
+  prev = nullptr;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::copy_from_object(
+    const LinkedList<T, Allocator> &object) {
+  // Reuse the nodes this list already owns by assigning over their payloads;
+  // for trivially copyable T this is a plain store per node
+  Node *current_node = _head;
+  const Node *source_node = object._head;
+  while (current_node != nullptr && source_node != nullptr) {
+    current_node->data = source_node->data;
     current_node = current_node->next;
+    source_node = source_node->next;
+  }
+
+  if (current_node != nullptr) {
+    // Destination was longer; cut the leftover nodes off in one piece
+    unlink_chain(current_node, _tail, _size - object._size);
+    free_chain(current_node);
+  } else if (source_node != nullptr) {
+    // Source was longer; the missing nodes are allocated as one batch
+    add_range(nullptr, object.IteratorTo(source_node), object.end(),
+              object._size - _size);
   }
 }
 
-template <typename T>
-void LinkedList<T>::remove_node(
-    Node *node) // Helper function for Remove() and RemoveAt()
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::remove_node(
+    Node *node) // Helper function for RemoveNode() and RemoveAt()
 {
   node->prev->next = node->next;
   node->next->prev = node->prev;
-  delete node;
+  destroy_node(node);
   _size--;
-}
\ No newline at end of file
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::create_node(Args &&...args) {
+  Node *node = NodeTraits::allocate(_alloc, 1);
+  try {
+    NodeTraits::construct(_alloc, node, std::in_place,
+                          std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(_alloc, node, 1); // Don't leak the raw slot
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::destroy_node(Node *node) {
+  NodeTraits::destroy(_alloc, node);
+  NodeTraits::deallocate(_alloc, node, 1);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::link_head(Node *new_head) {
+  if (_head == nullptr) // Check to see if list is empty
+  {
+    // If list was previously empty, list now has a size of 1 and thus _head and
+    // _tail are the same node
+    _head = new_head;
+    _tail = new_head;
+    _size = 1;
+  } else {
+    _head->prev = new_head; // Inform node currently at front of list that a new
+                            // node will be inserted in front of it
+    new_head->next = _head; // Set new_head to point to current front of list
+    _head = new_head;       // Set list to begin with new_head
+    new_head->prev = nullptr; // Since new_head is now at front of list, nothing
+                              // comes before it
+    _size++;                  // Increment size of linked list
+  }
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::link_tail(Node *new_tail) {
+  if (_head == nullptr) // Check to see if list is empty
+  {
+    // If list was previously empty, list now has a size of 1 and thus _tail and
+    // _head are the same node
+    _tail = new_tail;
+    _head = new_tail;
+    _size = 1;
+  } else {
+    _tail->next = new_tail;   // Inform node currently at end of list that a new
+                              // node will be inserted behind it
+    new_tail->prev = _tail;   // Set new_tail to point to current end of list
+    _tail = new_tail;         // Set list to end with new_tail
+    new_tail->next = nullptr; // Since new_tail is now at end of list, nothing
+                              // comes before it
+    _size++;                  // Increment size of linked list
+  }
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::link_after(Node *node, Node *new_node) {
+  if (node == _tail) {
+    link_tail(new_node); // Nothing in front of node to rewire
+    return;
+  }
+  new_node->prev = node;       // Inform new_node that node will be behind it
+  new_node->next = node->next; // Inform new_node that it should point to node
+                               // in front of node
+  node->next->prev =
+      new_node; // Inform node in front of node that new_node will be behind it
+  node->next = new_node; // Inform node that new_node is now ahead of it
+
+  _size++; // Increment size
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::link_before(Node *node, Node *new_node) {
+  if (node == _head) {
+    link_head(new_node); // See similar comments for link_after()
+    return;
+  }
+  new_node->next = node;
+  new_node->prev = node->prev;
+  node->prev->next = new_node;
+  node->prev = new_node;
+
+  _size++;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::link_chain(Node *position, Node *first,
+                                          Node *last, unsigned int count) {
+  Node *prev = position == nullptr ? _tail : position->prev;
+  first->prev = prev;
+  last->next = position;
+  if (prev != nullptr) {
+    prev->next = first;
+  } else {
+    _head = first;
+  }
+  if (position != nullptr) {
+    position->prev = last;
+  } else {
+    _tail = last;
+  }
+  _size += count;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::unlink_chain(Node *first, Node *last,
+                                            unsigned int count) {
+  if (first->prev != nullptr) {
+    first->prev->next = last->next;
+  } else {
+    _head = last->next;
+  }
+  if (last->next != nullptr) {
+    last->next->prev = first->prev;
+  } else {
+    _tail = first->prev;
+  }
+  first->prev = nullptr;
+  last->next = nullptr;
+  _size -= count;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::adopt_next_chain(Node *first) {
+  _head = first;
+  Node *prev = nullptr;
+  for (Node *node = first; node != nullptr; node = node->next) {
+    node->prev = prev;
+    prev = node;
+  }
+  _tail = prev;
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+void LinkedList<T, Allocator>::add_range(Node *position, InputIt first,
+                                         InputIt last) {
+  using Category = typename std::iterator_traits<InputIt>::iterator_category;
+  unsigned int expected = 0; // Single-pass ranges can't be measured up front
+  if (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+    expected = std::distance(first, last);
+  }
+  add_range(position, first, last, expected);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+void LinkedList<T, Allocator>::add_range(Node *position, InputIt first,
+                                         InputIt last,
+                                         unsigned int expected) {
+  if (expected > 0) {
+    reserve_nodes(expected);
+  }
+
+  // Allocate and link the new nodes among themselves without touching the
+  // list, then attach the whole chain with a single splice
+  Node *chain_head = nullptr;
+  Node *chain_tail = nullptr;
+  unsigned int count = 0;
+  try {
+    for (; first != last; ++first) {
+      Node *node = create_node(*first);
+      node->prev = chain_tail;
+      if (chain_tail != nullptr) {
+        chain_tail->next = node;
+      } else {
+        chain_head = node;
+      }
+      chain_tail = node;
+      count++;
+    }
+  } catch (...) {
+    free_chain(chain_head);
+    throw;
+  }
+
+  if (chain_head != nullptr) {
+    link_chain(position, chain_head, chain_tail, count);
+  }
+}
+
+// Allocators that expose reserve() (such as PoolAllocator) can hand out a
+// whole batch of nodes from one block; any other allocator is left alone
+template <typename Alloc>
+auto linked_list_reserve(Alloc &alloc, unsigned int count, int)
+    -> decltype(alloc.reserve(count), void()) {
+  alloc.reserve(count);
+}
+
+template <typename Alloc>
+void linked_list_reserve(Alloc &, unsigned int, long) {}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::reserve_nodes(unsigned int count) {
+  linked_list_reserve(_alloc, count, 0);
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::find_node(const T &data) const {
+  // The front cursor covers the first half and the back cursor the second, so
+  // a front match is always the first one; the back cursor remembers the
+  // nearest-to-front match it has seen in case the front finds nothing
+  Node *front = _head;
+  Node *back = _tail;
+  Node *back_match = nullptr;
+  for (unsigned int step = 0; step < _size / 2; step++) {
+    linked_list_prefetch(front->next);
+    linked_list_prefetch(back->prev);
+    if (front->data == data) {
+      return front;
+    }
+    if (back->data == data) {
+      back_match = back;
+    }
+    front = front->next;
+    back = back->prev;
+  }
+  if (_size % 2 == 1 && front->data == data) {
+    return front;
+  }
+  return back_match;
+}
+
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::Node *
+LinkedList<T, Allocator>::node_at(unsigned int index) const {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  Node *current_node;
+  if (index < _size / 2) {
+    current_node = _head;
+    for (unsigned int node = 0; node < index; node++) {
+      current_node = current_node->next;
+    }
+  } else {
+    current_node = _tail;
+    for (unsigned int node = _size - 1; node > index; node--) {
+      current_node = current_node->prev;
+    }
+  }
+  return current_node;
+}
+
+template <typename T, typename Allocator>
+unsigned int LinkedList<T, Allocator>::traversal_page_switches() const {
+  const std::uintptr_t page_size = 4096;
+  unsigned int pages = 0;
+  std::uintptr_t page = 0;
+  for (Node *node = _head; node != nullptr; node = node->next) {
+    std::uintptr_t current = reinterpret_cast<std::uintptr_t>(node) / page_size;
+    if (pages == 0 || current != page) {
+      pages++;
+      page = current;
+    }
+  }
+  return pages;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::free_nodes() {
+  free_chain(_head);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::free_chain(Node *first) {
+  // A copied stateful allocator may point at an arena or an unsynchronised
+  // pool that the reclaimer thread must not touch, so only stateless ones
+  // are deferred
+  if (NodeTraits::is_always_equal::value && _reclaimer != nullptr &&
+      first != nullptr) {
+    try {
+      // The chain is already detached, so the reclaimer thread owns it outright
+      _reclaimer->Defer([alloc = _alloc, first]() mutable {
+        release_chain(alloc, first);
+      });
+      return;
+    } catch (...) {
+      // Could not queue the job; fall back to releasing it here
+    }
+  }
+  release_chain(_alloc, first);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::release_chain(NodeAllocator &alloc,
+                                             Node *first) {
+  Node *current_node = first;
+  while (current_node != nullptr) // next member variable of last pointer in a
+                                  // linked list should always be null
+  {
+    Node *next =
+        current_node
+            ->next; // Summon the next node before deallocating the current node
+    linked_list_prefetch(next); // Overlap the next miss with the release
+    NodeTraits::destroy(alloc, current_node);
+    NodeTraits::deallocate(alloc, current_node, 1);
+    current_node = next;
+  }
+}
+
+// Integers that operator<< prints as numbers (not characters or true/false),
+// and so can be formatted with std::to_chars
+template <typename T>
+struct linked_list_uses_to_chars
+    : std::integral_constant<bool,
+                             std::is_integral<T>::value &&
+                                 !std::is_same<T, bool>::value &&
+                                 !std::is_same<T, char>::value &&
+                                 !std::is_same<T, signed char>::value &&
+                                 !std::is_same<T, unsigned char>::value> {};
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::write_chain(std::ostream &out, const Node *node,
+                                           bool forward,
+                                           char delimiter) const {
+  if constexpr (linked_list_uses_to_chars<T>::value) {
+    // to_chars ignores stream state, so only take the fast path when the
+    // stream would have produced the same digits
+    const std::ios_base::fmtflags format =
+        std::ios_base::basefield | std::ios_base::showpos;
+    if ((out.flags() & format) == std::ios_base::dec && out.width() == 0 &&
+        out.getloc() == std::locale::classic()) {
+      char buffer[4096]; // Written out whenever full; a small frame keeps
+                         // this safe on reclaimer and worker thread stacks
+      const unsigned int reserve = 64; // Room for any integer plus delimiter
+      char *end = buffer;
+      for (; node != nullptr; node = forward ? node->next : node->prev) {
+        if (end + reserve > buffer + sizeof(buffer)) {
+          out.write(buffer, end - buffer);
+          end = buffer;
+        }
+        end = std::to_chars(end, buffer + sizeof(buffer), node->data).ptr;
+        *end++ = delimiter;
+      }
+      out.write(buffer, end - buffer);
+      out.flush();
+      return;
+    }
+  }
+  for (; node != nullptr; node = forward ? node->next : node->prev) {
+    out << node->data << delimiter; // The stream buffers; no per-item flush
+  }
+  out.flush();
+}
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "LinkedList.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary snapshots of a LinkedList, so a large list can be written once and
+// reloaded at startup without replaying AddTail. A snapshot is
+//
+//   LinkedListSnapshotHeader   32 bytes, native byte order
+//   payload                    payload_bytes bytes
+//   checksum                   8 bytes, SnapshotChecksum of header and payload
+//
+// For trivially copyable T the payload is the elements' bytes back to back,
+// which MappedLinkedListView can iterate in place through mmap. Other types
+// are written as records by a serializer (see StringSerializer) and the header
+// records an element_size of 0.
+
+const std::uint32_t LinkedListSnapshotMagic = 0x4C4C5354; // "LLST"
+const std::uint32_t LinkedListSnapshotVersion = 2; // 2: header is checksummed
+
+struct LinkedListSnapshotHeader {
+  std::uint32_t magic;         // LinkedListSnapshotMagic; also detects a
+                               // file written with the other byte order
+  std::uint32_t version;       // Format version, LinkedListSnapshotVersion
+  std::uint32_t element_size;  // sizeof(T), or 0 for serialized records
+  std::uint32_t reserved;      // Zero
+  std::uint64_t count;         // Number of elements
+  std::uint64_t payload_bytes; // Size of the payload that follows
+};
+
+// Streaming 64-bit checksum over a byte sequence, eight bytes per step
+class SnapshotChecksum {
+public:
+  SnapshotChecksum();
+  void Update(const void *data, std::size_t size); // Add bytes in any pieces
+  std::uint64_t Value() const; // Checksum of every byte added so far
+
+private:
+  std::uint64_t _hash;          // State after the last complete word
+  std::uint64_t _length;        // Bytes added so far
+  unsigned char _pending[8];    // Bytes of an incomplete word
+  unsigned int _pending_size;   // Number of bytes in _pending
+
+  static std::uint64_t mix(std::uint64_t hash, std::uint64_t word);
+};
+
+// Serializer for std::string payloads: a 32-bit length followed by the bytes.
+// Any type with the same two members can be passed to SaveBinary/LoadBinary.
+struct StringSerializer {
+  void Write(std::string &out, const std::string &value) const;
+  std::string Read(const char *&cursor,
+                   const char *end) const; // Throws if the record is cut off
+};
+
+// Save/load for trivially copyable T
+template <typename T, typename Allocator>
+void SaveBinary(const LinkedList<T, Allocator> &list, std::ostream &out);
+template <typename T, typename Allocator>
+void LoadBinary(LinkedList<T, Allocator> &list, std::istream &in);
+
+// Save/load through a serializer
+template <typename T, typename Allocator, typename Serializer>
+void SaveBinary(const LinkedList<T, Allocator> &list, std::ostream &out,
+                const Serializer &serializer);
+template <typename T, typename Allocator, typename Serializer>
+void LoadBinary(LinkedList<T, Allocator> &list, std::istream &in,
+                const Serializer &serializer);
+
+// File versions of the above
+template <typename T, typename Allocator, typename... Serializer>
+void SaveBinary(const LinkedList<T, Allocator> &list, const std::string &path,
+                const Serializer &...serializer);
+template <typename T, typename Allocator, typename... Serializer>
+void LoadBinary(LinkedList<T, Allocator> &list, const std::string &path,
+                const Serializer &...serializer);
+
+inline SnapshotChecksum::SnapshotChecksum() {
+  _hash = 0x84222325CBF29CE4ULL;
+  _length = 0;
+  _pending_size = 0;
+}
+
+inline void SnapshotChecksum::Update(const void *data, std::size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  _length += size;
+  if (_pending_size != 0) {
+    while (_pending_size < 8 && size != 0) {
+      _pending[_pending_size++] = *bytes++;
+      size--;
+    }
+    if (_pending_size < 8) {
+      return;
+    }
+    std::uint64_t word;
+    std::memcpy(&word, _pending, 8);
+    _hash = mix(_hash, word);
+    _pending_size = 0;
+  }
+  for (; size >= 8; bytes += 8, size -= 8) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, 8);
+    _hash = mix(_hash, word);
+  }
+  std::memcpy(_pending, bytes, size);
+  _pending_size = size;
+}
+
+inline std::uint64_t SnapshotChecksum::Value() const {
+  std::uint64_t word = 0;
+  std::memcpy(&word, _pending, _pending_size);
+  std::uint64_t hash = mix(mix(_hash, word), _length);
+  hash ^= hash >> 31;
+  hash *= 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 29);
+}
+
+inline std::uint64_t SnapshotChecksum::mix(std::uint64_t hash,
+                                           std::uint64_t word) {
+  hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+  return hash ^ (hash >> 32);
+}
+
+inline void StringSerializer::Write(std::string &out,
+                                    const std::string &value) const {
+  if (value.size() > UINT32_MAX) {
+    throw std::length_error("Error: String too long for snapshot.");
+  }
+  std::uint32_t length = static_cast<std::uint32_t>(value.size());
+  out.append(reinterpret_cast<const char *>(&length), sizeof(length));
+  out.append(value);
+}
+
+inline std::string StringSerializer::Read(const char *&cursor,
+                                          const char *end) const {
+  std::uint32_t length;
+  if (static_cast<std::size_t>(end - cursor) < sizeof(length)) {
+    throw std::runtime_error("Error: Snapshot record is truncated.");
+  }
+  std::memcpy(&length, cursor, sizeof(length));
+  cursor += sizeof(length);
+  if (static_cast<std::size_t>(end - cursor) < length) {
+    throw std::runtime_error("Error: Snapshot record is truncated.");
+  }
+  std::string value(cursor, length);
+  cursor += length;
+  return value;
+}
+
+// Write the fixed-size header that starts every snapshot and add it to
+// checksum
+inline void snapshot_write_header(std::ostream &out, SnapshotChecksum &checksum,
+                                  std::uint32_t element_size,
+                                  std::uint64_t count,
+                                  std::uint64_t payload_bytes) {
+  LinkedListSnapshotHeader header = {LinkedListSnapshotMagic,
+                                     LinkedListSnapshotVersion,
+                                     element_size,
+                                     0,
+                                     count,
+                                     payload_bytes};
+  checksum.Update(&header, sizeof(header));
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+// Reject a header that is not a snapshot of elements of element_size bytes
+inline void snapshot_check_header(const LinkedListSnapshotHeader &header,
+                                  std::uint32_t element_size) {
+  if (header.magic != LinkedListSnapshotMagic) {
+    throw std::runtime_error("Error: Not a LinkedList snapshot.");
+  }
+  if (header.version != LinkedListSnapshotVersion) {
+    throw std::runtime_error("Error: Unsupported snapshot version.");
+  }
+  if (header.element_size != element_size ||
+      (element_size != 0 &&
+       (header.count > UINT64_MAX / element_size ||
+        header.payload_bytes != header.count * element_size))) {
+    throw std::runtime_error("Error: Snapshot element type mismatch.");
+  }
+}
+
+inline LinkedListSnapshotHeader
+snapshot_read_header(std::istream &in, SnapshotChecksum &checksum,
+                     std::uint32_t size) {
+  LinkedListSnapshotHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    throw std::runtime_error("Error: Snapshot is truncated.");
+  }
+  snapshot_check_header(header, size);
+  checksum.Update(&header, sizeof(header));
+  return header;
+}
+
+// Read a payload of bytes bytes. The header's size is not trusted until the
+// checksum matches, so it is checked against what a seekable stream has left
+// and otherwise the payload grows one bounded chunk at a time: a corrupt size
+// fails as truncated instead of allocating it all up front.
+inline void snapshot_read_payload(std::istream &in, std::string &payload,
+                                  std::uint64_t bytes) {
+  std::istream::pos_type here = in.tellg();
+  if (here != std::istream::pos_type(-1) && in.seekg(0, std::ios::end)) {
+    std::uint64_t left = std::uint64_t(in.tellg() - here);
+    in.seekg(here);
+    if (bytes > left) {
+      throw std::runtime_error("Error: Snapshot is truncated.");
+    }
+  }
+  in.clear(in.rdstate() & ~std::ios::failbit); // tellg/seekg may not apply
+
+  const std::size_t chunk = 1 << 16;
+  payload.clear();
+  while (payload.size() < bytes) {
+    std::size_t size = payload.size();
+    std::size_t step =
+        bytes - size < chunk ? std::size_t(bytes - size) : chunk;
+    payload.resize(size + step);
+    if (!in.read(&payload[size], step)) {
+      throw std::runtime_error("Error: Snapshot is truncated.");
+    }
+  }
+}
+
+inline void snapshot_check_trailer(std::istream &in, std::uint64_t expected) {
+  std::uint64_t checksum;
+  if (!in.read(reinterpret_cast<char *>(&checksum), sizeof(checksum))) {
+    throw std::runtime_error("Error: Snapshot is truncated.");
+  }
+  if (checksum != expected) {
+    throw std::runtime_error("Error: Snapshot checksum mismatch.");
+  }
+}
+
+template <typename T, typename Allocator>
+void SaveBinary(const LinkedList<T, Allocator> &list, std::ostream &out) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SaveBinary without a serializer needs trivially copyable T");
+  SnapshotChecksum checksum;
+  snapshot_write_header(out, checksum, sizeof(T), list.NodeCount(),
+                        std::uint64_t(list.NodeCount()) * sizeof(T));
+
+  // Gather elements into a large buffer so each write moves many of them
+  const std::size_t per_chunk = (1 << 16) / sizeof(T) + 1;
+  std::string chunk;
+  chunk.reserve(per_chunk * sizeof(T));
+  for (const T &value : list) {
+    chunk.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    if (chunk.size() == per_chunk * sizeof(T)) {
+      checksum.Update(chunk.data(), chunk.size());
+      out.write(chunk.data(), chunk.size());
+      chunk.clear();
+    }
+  }
+  checksum.Update(chunk.data(), chunk.size());
+  out.write(chunk.data(), chunk.size());
+
+  std::uint64_t value = checksum.Value();
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  if (!out.flush()) {
+    throw std::runtime_error("Error: Could not write snapshot.");
+  }
+}
+
+template <typename T, typename Allocator>
+void LoadBinary(LinkedList<T, Allocator> &list, std::istream &in) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "LoadBinary without a serializer needs trivially copyable T");
+  SnapshotChecksum checksum;
+  LinkedListSnapshotHeader header =
+      snapshot_read_header(in, checksum, sizeof(T));
+
+  // Build into a separate list so list is untouched if the snapshot is bad
+  LinkedList<T, Allocator> loaded(list.GetAllocator());
+  const std::size_t per_chunk = (1 << 16) / sizeof(T) + 1;
+  struct Element {
+    alignas(T) unsigned char bytes[sizeof(T)]; // Filled straight from the file
+  };
+  std::vector<Element> storage(per_chunk);
+  T *chunk = reinterpret_cast<T *>(storage.data());
+  for (std::uint64_t remaining = header.count; remaining != 0;) {
+    std::size_t count =
+        remaining < per_chunk ? std::size_t(remaining) : per_chunk;
+    if (!in.read(reinterpret_cast<char *>(chunk), count * sizeof(T))) {
+      throw std::runtime_error("Error: Snapshot is truncated.");
+    }
+    checksum.Update(chunk, count * sizeof(T));
+    loaded.AddNodesTail(chunk, count); // One batched chain per chunk
+    remaining -= count;
+  }
+  snapshot_check_trailer(in, checksum.Value());
+  list = std::move(loaded);
+}
+
+template <typename T, typename Allocator, typename Serializer>
+void SaveBinary(const LinkedList<T, Allocator> &list, std::ostream &out,
+                const Serializer &serializer) {
+  std::string payload; // Records vary in size, so the length comes first
+  for (const T &value : list) {
+    serializer.Write(payload, value);
+  }
+  SnapshotChecksum checksum;
+  snapshot_write_header(out, checksum, 0, list.NodeCount(), payload.size());
+  checksum.Update(payload.data(), payload.size());
+  std::uint64_t value = checksum.Value();
+  out.write(payload.data(), payload.size());
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  if (!out.flush()) {
+    throw std::runtime_error("Error: Could not write snapshot.");
+  }
+}
+
+template <typename T, typename Allocator, typename Serializer>
+void LoadBinary(LinkedList<T, Allocator> &list, std::istream &in,
+                const Serializer &serializer) {
+  SnapshotChecksum checksum;
+  LinkedListSnapshotHeader header = snapshot_read_header(in, checksum, 0);
+  std::string payload;
+  snapshot_read_payload(in, payload, header.payload_bytes);
+  checksum.Update(payload.data(), payload.size());
+  snapshot_check_trailer(in, checksum.Value());
+
+  LinkedList<T, Allocator> loaded(list.GetAllocator());
+  const char *cursor = payload.data();
+  const char *end = cursor + payload.size();
+  for (std::uint64_t i = 0; i < header.count; i++) {
+    loaded.AddTail(serializer.Read(cursor, end));
+  }
+  if (cursor != end) {
+    throw std::runtime_error("Error: Snapshot has trailing data.");
+  }
+  list = std::move(loaded);
+}
+
+template <typename T, typename Allocator, typename... Serializer>
+void SaveBinary(const LinkedList<T, Allocator> &list, const std::string &path,
+                const Serializer &...serializer) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Error: Could not open " + path + ".");
+  }
+  SaveBinary(list, static_cast<std::ostream &>(out), serializer...);
+}
+
+template <typename T, typename Allocator, typename... Serializer>
+void LoadBinary(LinkedList<T, Allocator> &list, const std::string &path,
+                const Serializer &...serializer) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Error: Could not open " + path + ".");
+  }
+  LoadBinary(list, static_cast<std::istream &>(in), serializer...);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Read-only view of a snapshot file of trivially copyable T, mapped with mmap.
+// Elements are read straight out of the page cache: opening the view costs
+// one header check and no nodes are ever built.
+template <typename T> class MappedLinkedListView {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "MappedLinkedListView needs trivially copyable T");
+  static_assert(alignof(T) <= sizeof(LinkedListSnapshotHeader),
+                "Elements following the header would be misaligned");
+
+public:
+  using value_type = T;
+  using const_iterator = const T *;
+
+  // Construction / destruction
+  explicit MappedLinkedListView(const std::string &path); // Map a snapshot
+  MappedLinkedListView(const MappedLinkedListView &) = delete;
+  MappedLinkedListView &operator=(const MappedLinkedListView &) = delete;
+  ~MappedLinkedListView(); // Unmaps the file
+
+  // Accessors
+  unsigned long long NodeCount() const; // Number of elements in the file
+  bool Verify() const; // Recompute the checksum (reads every page once)
+  const T &operator[](unsigned long long index) const; // Subscript operator
+
+  // Iteration
+  const_iterator begin() const; // First element in the file
+  const_iterator end() const;   // Past the last element in the file
+
+private:
+  // Member variables
+  void *_mapping;       // Start of the mapped file
+  std::size_t _length;  // Bytes mapped
+  const T *_elements;   // First element, just past the header
+  std::uint64_t _count; // Number of elements
+};
+
+template <typename T>
+MappedLinkedListView<T>::MappedLinkedListView(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Error: Could not open " + path + ".");
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      std::uint64_t(info.st_size) < sizeof(LinkedListSnapshotHeader) +
+                                        sizeof(std::uint64_t)) {
+    ::close(fd);
+    throw std::runtime_error("Error: Snapshot is truncated.");
+  }
+  _length = info.st_size;
+  _mapping = ::mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping keeps the file alive
+  if (_mapping == MAP_FAILED) {
+    throw std::runtime_error("Error: Could not map " + path + ".");
+  }
+
+  try {
+    LinkedListSnapshotHeader header;
+    std::memcpy(&header, _mapping, sizeof(header));
+    snapshot_check_header(header, sizeof(T));
+    std::size_t payload = _length - sizeof(header) - sizeof(std::uint64_t);
+    if (header.payload_bytes != payload) {
+      throw std::runtime_error("Error: Snapshot is truncated.");
+    }
+    _count = header.count;
+  } catch (...) {
+    ::munmap(_mapping, _length);
+    throw;
+  }
+  _elements = reinterpret_cast<const T *>(static_cast<const char *>(_mapping) +
+                                          sizeof(LinkedListSnapshotHeader));
+}
+
+template <typename T> MappedLinkedListView<T>::~MappedLinkedListView() {
+  ::munmap(_mapping, _length);
+}
+
+template <typename T>
+unsigned long long MappedLinkedListView<T>::NodeCount() const {
+  return _count;
+}
+
+template <typename T> bool MappedLinkedListView<T>::Verify() const {
+  SnapshotChecksum checksum;
+  checksum.Update(_mapping, sizeof(LinkedListSnapshotHeader));
+  checksum.Update(_elements, _count * sizeof(T));
+  std::uint64_t stored;
+  std::memcpy(&stored, _elements + _count, sizeof(stored));
+  return stored == checksum.Value();
+}
+
+template <typename T>
+const T &MappedLinkedListView<T>::operator[](unsigned long long index) const {
+  if (index >= _count) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  return _elements[index];
+}
+
+template <typename T>
+typename MappedLinkedListView<T>::const_iterator
+MappedLinkedListView<T>::begin() const {
+  return _elements;
+}
+
+template <typename T>
+typename MappedLinkedListView<T>::const_iterator
+MappedLinkedListView<T>::end() const {
+  return _elements + _count;
+}
+#endif
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Slab allocator for fixed-size nodes. Slots are carved out of large blocks and
+// freed slots are threaded onto an intrusive free list, so once the pool has
+// warmed up, allocation and release never touch the global heap.
+class NodePool {
+public:
+  // Construction / destruction
+  explicit NodePool(std::size_t slots_per_block = 256); // Slots per new block
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  ~NodePool(); // Returns every block to the global heap
+
+  // Behaviors
+  void *Allocate(std::size_t size);          // Pop a slot off the free list
+  void Deallocate(void *slot, std::size_t size); // Push a slot onto free list
+  void Reserve(std::size_t slots, std::size_t size); // Pre-carve free slots
+  void ReserveContiguous(std::size_t slots,
+                         std::size_t size); // Put a fresh block of slots on
+                                            // top of the free list
+  std::size_t Trim(); // Free blocks with no slot in use; returns bytes freed
+
+  // Accessors
+  std::size_t SlotSize() const;   // Size of each slot (0 until first use)
+  std::size_t BlockCount() const; // Number of blocks obtained from the heap
+  std::size_t FreeCount() const;  // Number of slots sitting on the free list
+
+private:
+  struct FreeSlot {
+    FreeSlot *next; // Next free slot; overlays the released node's storage
+  };
+  struct Block {
+    char *start;       // First slot in the block
+    std::size_t slots; // Number of slots carved from the block
+  };
+
+  // Member variables
+  std::size_t _slot_size;       // Rounded-up size of every slot in the pool
+  std::size_t _slots_per_block; // Slots carved from each fresh block
+  std::vector<Block> _blocks;   // Every block owned by the pool
+  FreeSlot *_free;              // Top of the free list
+  std::size_t _free_count;      // Number of slots on the free list
+
+  // Private behaviors
+  bool serves(std::size_t size); // Check/fix the slot size for a request
+  void add_block(std::size_t slots); // Allocate a block and thread its slots
+};
+
+// Standard allocator backed by a NodePool. Copies (including rebound copies)
+// share the same pool, so a LinkedList<T, PoolAllocator<T>> and its allocator
+// recycle the same nodes. Only single-object requests are pooled; anything
+// else goes straight to the global heap.
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  // Construction
+  PoolAllocator(); // Creates a fresh pool
+  explicit PoolAllocator(std::size_t slots_per_block);
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept; // Shares other's pool
+  PoolAllocator(const PoolAllocator &other) noexcept; // Shares other's pool
+  PoolAllocator(PoolAllocator &&other) noexcept; // Same; other keeps its pool
+  PoolAllocator &operator=(const PoolAllocator &other) noexcept;
+  PoolAllocator &operator=(PoolAllocator &&other) noexcept; // Copies _pool
+
+  // Behaviors
+  T *allocate(std::size_t n);
+  void deallocate(T *p, std::size_t n);
+  void reserve(std::size_t n); // Make sure n nodes can be handed out in a row
+  void reserve_contiguous(std::size_t n); // Next n nodes are adjacent
+  std::size_t trim(); // Return empty blocks to the heap; returns bytes freed
+
+  // Accessors
+  NodePool &pool() const; // The pool shared by every copy of this allocator
+
+  template <typename U> friend class PoolAllocator;
+
+private:
+  std::shared_ptr<NodePool> _pool; // Shared with every copy of the allocator
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &lhs, const PoolAllocator<U> &rhs) {
+  return &lhs.pool() == &rhs.pool();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &lhs, const PoolAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+inline NodePool::NodePool(std::size_t slots_per_block) {
+  _slot_size = 0;
+  _slots_per_block = slots_per_block == 0 ? 1 : slots_per_block;
+  _free = nullptr;
+  _free_count = 0;
+}
+
+inline NodePool::~NodePool() {
+  for (const Block &block : _blocks) {
+    ::operator delete(block.start);
+  }
+}
+
+inline void *NodePool::Allocate(std::size_t size) {
+  if (!serves(size)) {
+    return ::operator new(size);
+  }
+  if (_free == nullptr) {
+    add_block(_slots_per_block);
+  }
+  FreeSlot *slot = _free;
+  _free = slot->next;
+  _free_count--;
+  return slot;
+}
+
+inline void NodePool::Deallocate(void *slot, std::size_t size) {
+  if (slot == nullptr) {
+    return;
+  }
+  if (!serves(size)) {
+    ::operator delete(slot);
+    return;
+  }
+  FreeSlot *freed = static_cast<FreeSlot *>(slot);
+  freed->next = _free;
+  _free = freed;
+  _free_count++;
+}
+
+inline void NodePool::Reserve(std::size_t slots, std::size_t size) {
+  if (serves(size) && slots > _free_count) {
+    add_block(slots - _free_count); // One block covers the whole shortfall
+  }
+}
+
+inline void NodePool::ReserveContiguous(std::size_t slots, std::size_t size) {
+  if (serves(size) && slots != 0) {
+    add_block(slots); // Handed out next, in address order
+  }
+}
+
+inline std::size_t NodePool::Trim() {
+  if (_free_count == 0) {
+    return 0;
+  }
+
+  // Count the free slots in each block, looking blocks up by address
+  std::vector<Block> blocks = _blocks;
+  std::sort(blocks.begin(), blocks.end(),
+            [](const Block &lhs, const Block &rhs) {
+              return std::less<char *>()(lhs.start, rhs.start);
+            });
+  std::vector<std::size_t> free_slots(blocks.size(), 0);
+  auto block_of = [&blocks](const void *slot) {
+    const char *address = static_cast<const char *>(slot);
+    auto after = std::upper_bound(
+        blocks.begin(), blocks.end(), address,
+        [](const char *lhs, const Block &rhs) {
+          return std::less<const char *>()(lhs, rhs.start);
+        });
+    return static_cast<std::size_t>(after - blocks.begin() - 1);
+  };
+  for (FreeSlot *slot = _free; slot != nullptr; slot = slot->next) {
+    free_slots[block_of(slot)]++;
+  }
+
+  std::vector<bool> empty(blocks.size());
+  bool any_empty = false;
+  for (std::size_t i = 0; i < blocks.size(); i++) {
+    empty[i] = free_slots[i] == blocks[i].slots;
+    any_empty = any_empty || empty[i];
+  }
+  if (!any_empty) {
+    return 0;
+  }
+
+  // Drop the empty blocks' slots from the free list, keeping the rest in order
+  FreeSlot **link = &_free;
+  while (*link != nullptr) {
+    if (empty[block_of(*link)]) {
+      *link = (*link)->next;
+      _free_count--;
+    } else {
+      link = &(*link)->next;
+    }
+  }
+
+  std::size_t freed = 0;
+  _blocks.clear();
+  for (std::size_t i = 0; i < blocks.size(); i++) {
+    if (empty[i]) {
+      freed += blocks[i].slots * _slot_size;
+      ::operator delete(blocks[i].start);
+    } else {
+      _blocks.push_back(blocks[i]);
+    }
+  }
+  return freed;
+}
+
+inline std::size_t NodePool::SlotSize() const { return _slot_size; }
+
+inline std::size_t NodePool::BlockCount() const { return _blocks.size(); }
+
+inline std::size_t NodePool::FreeCount() const { return _free_count; }
+
+inline bool NodePool::serves(std::size_t size) {
+  const std::size_t align = alignof(std::max_align_t);
+  std::size_t rounded = size < sizeof(FreeSlot) ? sizeof(FreeSlot) : size;
+  rounded = (rounded + align - 1) / align * align;
+  if (_slot_size == 0) {
+    _slot_size = rounded; // The first request fixes the slot size
+  }
+  return rounded == _slot_size;
+}
+
+inline void NodePool::add_block(std::size_t slots) {
+  char *block = static_cast<char *>(::operator new(slots * _slot_size));
+  _blocks.push_back(Block{block, slots});
+
+  // Thread the new slots in address order so consecutive allocations are
+  // adjacent in memory
+  for (std::size_t i = slots; i > 0; i--) {
+    FreeSlot *slot = reinterpret_cast<FreeSlot *>(block + (i - 1) * _slot_size);
+    slot->next = _free;
+    _free = slot;
+  }
+  _free_count += slots;
+}
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator() : _pool(std::make_shared<NodePool>()) {}
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator(std::size_t slots_per_block)
+    : _pool(std::make_shared<NodePool>(slots_per_block)) {}
+
+template <typename T>
+template <typename U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U> &other) noexcept
+    : _pool(other._pool) {}
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator &other) noexcept
+    : _pool(other._pool) {}
+
+// A moved-from allocator must still compare equal to (and allocate like) the
+// original, so moving shares the pool exactly as copying does
+template <typename T>
+PoolAllocator<T>::PoolAllocator(PoolAllocator &&other) noexcept
+    : _pool(other._pool) {}
+
+template <typename T>
+PoolAllocator<T> &
+PoolAllocator<T>::operator=(const PoolAllocator &other) noexcept {
+  _pool = other._pool;
+  return *this;
+}
+
+template <typename T>
+PoolAllocator<T> &PoolAllocator<T>::operator=(PoolAllocator &&other) noexcept {
+  _pool = other._pool;
+  return *this;
+}
+
+template <typename T> T *PoolAllocator<T>::allocate(std::size_t n) {
+  if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+    return std::allocator<T>().allocate(n);
+  }
+  return static_cast<T *>(_pool->Allocate(sizeof(T)));
+}
+
+template <typename T> void PoolAllocator<T>::deallocate(T *p, std::size_t n) {
+  if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+    std::allocator<T>().deallocate(p, n);
+    return;
+  }
+  _pool->Deallocate(p, sizeof(T));
+}
+
+template <typename T> void PoolAllocator<T>::reserve(std::size_t n) {
+  _pool->Reserve(n, sizeof(T));
+}
+
+template <typename T> void PoolAllocator<T>::reserve_contiguous(std::size_t n) {
+  _pool->ReserveContiguous(n, sizeof(T));
+}
+
+template <typename T> std::size_t PoolAllocator<T>::trim() {
+  return _pool->Trim();
+}
+
+template <typename T> NodePool &PoolAllocator<T>::pool() const {
+  return *_pool;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Background thread that runs deferred teardown work. A LinkedList given a
+// reclaimer (LinkedList::SetReclaimer) detaches its node chain in O(1) on
+// Clear() or destruction and queues the actual release here, so the calling
+// thread never pays for freeing a long list.
+//
+// Jobs run one at a time in the order they were queued. Drain() waits for
+// every job queued so far; the destructor drains and then stops the thread.
+class NodeReclaimer {
+public:
+  // Construction / destruction
+  NodeReclaimer(); // Starts the reclaimer thread
+  NodeReclaimer(const NodeReclaimer &) = delete;
+  NodeReclaimer &operator=(const NodeReclaimer &) = delete;
+  ~NodeReclaimer(); // Finishes outstanding work, then joins the thread
+
+  // Behaviors
+  void Defer(std::function<void()> job); // Queue job for the reclaimer thread
+  void Drain(); // Block until every job queued so far has finished
+
+  // Accessors
+  std::size_t Pending() const; // Jobs queued or running; may be stale
+
+private:
+  // Member variables
+  mutable std::mutex _lock;               // Guards everything below
+  std::condition_variable _work_ready;    // Signalled when a job is queued
+  std::condition_variable _drained;       // Signalled when the queue empties
+  std::deque<std::function<void()>> _jobs; // Jobs not yet started
+  bool _busy;                             // Whether a job is running
+  bool _stopping;                         // Set by the destructor
+  std::thread _worker;                    // Runs the jobs
+
+  // Private behaviors
+  void run(); // Body of the reclaimer thread
+};
+
+inline NodeReclaimer::NodeReclaimer() : _busy(false), _stopping(false) {
+  _worker = std::thread(&NodeReclaimer::run, this);
+}
+
+inline NodeReclaimer::~NodeReclaimer() {
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stopping = true;
+  }
+  _work_ready.notify_one();
+  _worker.join(); // run() only returns once the queue is empty
+}
+
+inline void NodeReclaimer::Defer(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _jobs.push_back(std::move(job));
+  }
+  _work_ready.notify_one();
+}
+
+inline void NodeReclaimer::Drain() {
+  std::unique_lock<std::mutex> guard(_lock);
+  _drained.wait(guard, [this] { return _jobs.empty() && !_busy; });
+}
+
+inline std::size_t NodeReclaimer::Pending() const {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _jobs.size() + (_busy ? 1 : 0);
+}
+
+inline void NodeReclaimer::run() {
+  std::unique_lock<std::mutex> guard(_lock);
+  for (;;) {
+    _work_ready.wait(guard, [this] { return _stopping || !_jobs.empty(); });
+    if (_jobs.empty()) {
+      return; // Stopping, and nothing left to do
+    }
+    std::function<void()> job = std::move(_jobs.front());
+    _jobs.pop_front();
+    _busy = true;
+    guard.unlock();
+    job(); // Release nodes without holding the lock
+    guard.lock();
+    _busy = false;
+    if (_jobs.empty()) {
+      _drained.notify_all();
+    }
+  }
+}
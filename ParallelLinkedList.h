@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "LinkedList.h"
+
+// Parallel scans over a LinkedList. A single split pass walks the list once
+// to record anchor nodes that cut it into segments; worker threads then claim
+// segments from a shared counter (so a thread that finishes early picks up
+// the remaining work) and scan them independently. Per-segment results are
+// concatenated in segment order, so output is always in list order.
+//
+// The list must not be modified by other threads while a scan runs. Lists
+// shorter than ParallelMinimumSegment nodes per thread are scanned serially.
+
+const unsigned int ParallelMinimumSegment = 4096; // Nodes worth a thread
+const unsigned int ParallelSegmentsPerThread = 4; // Over-decomposition factor
+
+// Split [_head, nullptr) into segments of roughly equal length, returning the
+// first node of each segment plus a trailing nullptr
+template <typename Node>
+std::vector<Node *> parallel_anchors(Node *head, unsigned int size,
+                                     unsigned int segments) {
+  std::vector<Node *> anchors;
+  anchors.reserve(segments + 1);
+  unsigned int segment_length = (size + segments - 1) / segments;
+  unsigned int position = 0;
+  for (Node *node = head; node != nullptr; node = node->next, position++) {
+    if (position % segment_length == 0) {
+      anchors.push_back(node);
+    }
+  }
+  anchors.push_back(nullptr);
+  return anchors;
+}
+
+// Number of worker threads to use for a list of size nodes
+inline unsigned int parallel_threads(unsigned int size, unsigned int threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max(1u, std::min(threads, size / ParallelMinimumSegment));
+}
+
+// Run scan(segment_index, first, stop) over every segment of the list
+template <typename Node, typename Scan>
+unsigned int parallel_segments(Node *head, unsigned int size,
+                               unsigned int threads, Scan scan) {
+  threads = parallel_threads(size, threads);
+  if (threads == 1) {
+    scan(0u, head, static_cast<Node *>(nullptr));
+    return 1;
+  }
+
+  std::vector<Node *> anchors =
+      parallel_anchors(head, size, threads * ParallelSegmentsPerThread);
+  unsigned int segments = anchors.size() - 1;
+  std::atomic<unsigned int> next_segment(0);
+  auto worker = [&]() {
+    unsigned int segment;
+    while ((segment = next_segment.fetch_add(1)) < segments) {
+      scan(segment, anchors[segment], anchors[segment + 1]);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned int i = 1; i < threads; i++) {
+    pool.emplace_back(worker);
+  }
+  worker(); // The calling thread works too
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+  return segments;
+}
+
+// Call fn(value) for every element; fn must be safe to call concurrently
+template <typename T, typename Allocator, typename Function>
+void ParallelForEach(LinkedList<T, Allocator> &list, Function fn,
+                     unsigned int threads = 0) {
+  using Node = typename LinkedList<T, Allocator>::Node;
+  parallel_segments(list.Head(), list.NodeCount(), threads,
+                    [&fn](unsigned int, Node *first, Node *stop) {
+                      for (Node *node = first; node != stop;
+                           node = node->next) {
+                        fn(node->data);
+                      }
+                    });
+}
+
+template <typename T, typename Allocator, typename Function>
+void ParallelForEach(const LinkedList<T, Allocator> &list, Function fn,
+                     unsigned int threads = 0) {
+  using Node = const typename LinkedList<T, Allocator>::Node;
+  parallel_segments(list.Head(), list.NodeCount(), threads,
+                    [&fn](unsigned int, Node *first, Node *stop) {
+                      for (Node *node = first; node != stop;
+                           node = node->next) {
+                        fn(node->data);
+                      }
+                    });
+}
+
+// Parallel FindAll for any predicate; matches are appended in list order
+template <typename T, typename Allocator, typename Predicate>
+void ParallelFindIf(const LinkedList<T, Allocator> &list,
+                    vector<typename LinkedList<T, Allocator>::Node *> &outData,
+                    Predicate pred, unsigned int threads = 0) {
+  using Node = typename LinkedList<T, Allocator>::Node;
+  unsigned int segments = parallel_threads(list.NodeCount(), threads) *
+                          ParallelSegmentsPerThread;
+  std::vector<std::vector<Node *>> found(segments + 1);
+  Node *head = const_cast<Node *>(list.Head());
+  parallel_segments(head, list.NodeCount(), threads,
+                    [&](unsigned int segment, Node *first, Node *stop) {
+                      std::vector<Node *> &matches = found[segment];
+                      for (Node *node = first; node != stop;
+                           node = node->next) {
+                        if (pred(static_cast<const T &>(node->data))) {
+                          matches.push_back(node);
+                        }
+                      }
+                    });
+  for (const std::vector<Node *> &matches : found) {
+    outData.insert(outData.end(), matches.begin(), matches.end());
+  }
+}
+
+// Parallel version of LinkedList::FindAll
+template <typename T, typename Allocator>
+void ParallelFindAll(const LinkedList<T, Allocator> &list,
+                     vector<typename LinkedList<T, Allocator>::Node *> &outData,
+                     const T &value, unsigned int threads = 0) {
+  ParallelFindIf(
+      list, outData, [&value](const T &data) { return data == value; },
+      threads);
+}
+
+// Parallel version of LinkedList::RemoveIf. Matches are found in parallel,
+// then unlinked by the calling thread in O(matches).
+template <typename T, typename Allocator, typename Predicate>
+unsigned int ParallelRemoveIf(LinkedList<T, Allocator> &list, Predicate pred,
+                              unsigned int threads = 0) {
+  vector<typename LinkedList<T, Allocator>::Node *> matches;
+  ParallelFindIf(list, matches, pred, threads);
+  for (auto node : matches) {
+    list.RemoveNode(node);
+  }
+  return matches.size();
+}
+
+// Parallel version of LinkedList::Remove
+template <typename T, typename Allocator>
+unsigned int ParallelRemove(LinkedList<T, Allocator> &list, const T &data,
+                            unsigned int threads = 0) {
+  // Nothing is unlinked until the scan is over, so data may alias a match
+  return ParallelRemoveIf(
+      list, [&data](const T &element) { return element == data; }, threads);
+}
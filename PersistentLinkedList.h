@@ -0,0 +1,390 @@
+#pragma once
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AtomicSharedPtr.h"
+
+// Persistent (versioned) list for readers that must see a consistent view
+// while a writer keeps changing it. Elements are stored in an implicit treap
+// (ordered by position, heap-ordered by a random priority) whose nodes are
+// immutable once built. A change copies only the O(log n) nodes on the path
+// it touches and shares everything else with the previous version.
+//
+// Snapshot() is O(1): it atomically loads the current root (see
+// AtomicSharedPtr; the load is brief but not lock-free). A Version keeps its
+// nodes alive for as long as it is held and never changes, so readers iterate
+// it with no synchronisation at all. Writers serialise on _write_lock, build
+// the new version off to the side and publish it with a single atomic store;
+// a reader never waits for a writer's work, and the writer never waits for
+// readers to finish with older versions.
+template <typename T> class PersistentLinkedList {
+  struct Node; // Declaration of immutable treap node
+  using NodePointer = std::shared_ptr<const Node>;
+
+public:
+  class Version; // Declaration of immutable snapshot
+
+  // Construction
+  PersistentLinkedList(); // Default constructor
+  PersistentLinkedList(const PersistentLinkedList &) = delete;
+  PersistentLinkedList &operator=(const PersistentLinkedList &) = delete;
+
+  // Readers (never wait for a writer's work)
+  Version Snapshot() const;       // Current version, O(1)
+  unsigned int NodeCount() const; // Size of the current version
+  T At(unsigned int index) const; // Copy of the nth value; throws if absent
+  void PrintForward() const;      // Print current version in order
+
+  // Writers (serialised among themselves, O(log n) each unless noted)
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void InsertAt(const T &data,
+                unsigned int index); // Insert node at given index
+  void Set(unsigned int index, const T &data); // Replace the nth value
+  bool RemoveAt(unsigned int index);           // Delete node at index
+  unsigned int Remove(const T &data); // Delete all nodes containing data;
+                                      // O(n + matches * log n)
+  void Clear();                       // Publish an empty list
+
+private:
+  // Member variables
+  AtomicSharedPtr<const Node> _root; // Published version
+  std::mutex _write_lock;            // Serialises writers
+  unsigned int _priority; // State of the priority generator; writers only
+
+  // Private behaviors
+  static unsigned int size(const NodePointer &node); // 0 for nullptr
+  static NodePointer make(const T &data, unsigned int priority,
+                          NodePointer left,
+                          NodePointer right); // New node over two subtrees
+  static std::pair<NodePointer, NodePointer>
+  split(const NodePointer &node,
+        unsigned int count); // First count nodes, and the rest
+  static NodePointer merge(const NodePointer &left,
+                           const NodePointer &right); // left then right
+  static const Node *select(const Node *node,
+                            unsigned int index); // nth node in order
+  unsigned int next_priority(); // Fresh xorshift32 priority
+  void publish(NodePointer root); // Make root the current version
+};
+
+// Immutable treap node for PersistentLinkedList class
+template <typename T> struct PersistentLinkedList<T>::Node {
+  T data;                // Data stored in the node
+  NodePointer left;      // Elements before this one in the subtree
+  NodePointer right;     // Elements after this one in the subtree
+  unsigned int size;     // Number of nodes in this subtree
+  unsigned int priority; // Heap priority; larger values sit closer to root
+
+  Node(const T &data, unsigned int priority, NodePointer left,
+       NodePointer right)
+      : data(data), left(std::move(left)), right(std::move(right)),
+        size(PersistentLinkedList::size(this->left) + 1 +
+             PersistentLinkedList::size(this->right)),
+        priority(priority) {}
+};
+
+// Immutable view of one version of a PersistentLinkedList
+template <typename T> class PersistentLinkedList<T>::Version {
+public:
+  class const_iterator; // Declaration of in-order forward iterator
+
+  Version() = default; // Empty version
+
+  // Accessors
+  unsigned int NodeCount() const; // Number of elements in this version
+  const T *Find(const T &data) const; // First element equal to data
+  void PrintForward() const;          // Print all items in order
+
+  // Iteration
+  const_iterator begin() const; // Iterator to the first element
+  const_iterator end() const;   // Iterator past the last element
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator, O(log n)
+
+private:
+  friend class PersistentLinkedList;
+  explicit Version(NodePointer root) : _root(std::move(root)) {}
+
+  NodePointer _root; // Keeps every node of this version alive
+};
+
+// In-order iterator over a Version; holds the path to the current node
+template <typename T> class PersistentLinkedList<T>::Version::const_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T *;
+  using reference = const T &;
+
+  const_iterator() = default;
+  explicit const_iterator(const Node *root) { push_left(root); }
+
+  reference operator*() const { return _path.back()->data; }
+  pointer operator->() const { return &_path.back()->data; }
+
+  const_iterator &operator++() {
+    const Node *node = _path.back();
+    _path.pop_back();
+    push_left(node->right.get());
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator previous = *this;
+    ++*this;
+    return previous;
+  }
+
+  friend bool operator==(const const_iterator &lhs,
+                         const const_iterator &rhs) {
+    return lhs.current() == rhs.current();
+  }
+  friend bool operator!=(const const_iterator &lhs,
+                         const const_iterator &rhs) {
+    return lhs.current() != rhs.current();
+  }
+
+private:
+  std::vector<const Node *> _path; // Ancestors still to visit, current last
+
+  const Node *current() const {
+    return _path.empty() ? nullptr : _path.back();
+  }
+  void push_left(const Node *node) {
+    for (; node != nullptr; node = node->left.get()) {
+      _path.push_back(node);
+    }
+  }
+};
+
+template <typename T> PersistentLinkedList<T>::PersistentLinkedList() {
+  _priority = 2463534242u;
+}
+
+template <typename T>
+typename PersistentLinkedList<T>::Version
+PersistentLinkedList<T>::Snapshot() const {
+  return Version(_root.Load());
+}
+
+template <typename T> unsigned int PersistentLinkedList<T>::NodeCount() const {
+  return Snapshot().NodeCount();
+}
+
+template <typename T> T PersistentLinkedList<T>::At(unsigned int index) const {
+  Version version = Snapshot(); // Keeps the node alive while it is copied
+  return version[index];
+}
+
+template <typename T> void PersistentLinkedList<T>::PrintForward() const {
+  Snapshot().PrintForward();
+}
+
+template <typename T> void PersistentLinkedList<T>::AddHead(const T &data) {
+  InsertAt(data, 0);
+}
+
+template <typename T> void PersistentLinkedList<T>::AddTail(const T &data) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  NodePointer root = _root.Load();
+  publish(merge(root, make(data, next_priority(), nullptr, nullptr)));
+}
+
+template <typename T>
+void PersistentLinkedList<T>::InsertAt(const T &data, unsigned int index) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  NodePointer root = _root.Load();
+  if (index > size(root)) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  std::pair<NodePointer, NodePointer> halves = split(root, index);
+  NodePointer node = make(data, next_priority(), nullptr, nullptr);
+  publish(merge(merge(halves.first, node), halves.second));
+}
+
+template <typename T>
+void PersistentLinkedList<T>::Set(unsigned int index, const T &data) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  NodePointer root = _root.Load();
+  if (index >= size(root)) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  std::pair<NodePointer, NodePointer> halves = split(root, index);
+  std::pair<NodePointer, NodePointer> rest = split(halves.second, 1);
+  NodePointer node = make(data, rest.first->priority, nullptr, nullptr);
+  publish(merge(merge(halves.first, node), rest.second));
+}
+
+template <typename T>
+bool PersistentLinkedList<T>::RemoveAt(unsigned int index) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  NodePointer root = _root.Load();
+  if (index >= size(root)) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  std::pair<NodePointer, NodePointer> halves = split(root, index);
+  publish(merge(halves.first, split(halves.second, 1).second));
+  return true;
+}
+
+template <typename T>
+unsigned int PersistentLinkedList<T>::Remove(const T &data) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  NodePointer root = _root.Load();
+
+  // Find every match in one in-order pass, then cut them out back to front
+  // so earlier indices stay valid
+  std::vector<unsigned int> matches;
+  unsigned int index = 0;
+  for (const T &element : Version(root)) {
+    if (element == data) {
+      matches.push_back(index);
+    }
+    index++;
+  }
+  if (matches.empty()) {
+    return 0;
+  }
+  for (auto match = matches.rbegin(); match != matches.rend(); ++match) {
+    std::pair<NodePointer, NodePointer> halves = split(root, *match);
+    root = merge(halves.first, split(halves.second, 1).second);
+  }
+  publish(std::move(root));
+  return matches.size();
+}
+
+template <typename T> void PersistentLinkedList<T>::Clear() {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  publish(nullptr);
+}
+
+template <typename T>
+unsigned int PersistentLinkedList<T>::size(const NodePointer &node) {
+  return node != nullptr ? node->size : 0;
+}
+
+template <typename T>
+typename PersistentLinkedList<T>::NodePointer
+PersistentLinkedList<T>::make(const T &data, unsigned int priority,
+                              NodePointer left, NodePointer right) {
+  return std::make_shared<const Node>(data, priority, std::move(left),
+                                      std::move(right));
+}
+
+template <typename T>
+std::pair<typename PersistentLinkedList<T>::NodePointer,
+          typename PersistentLinkedList<T>::NodePointer>
+PersistentLinkedList<T>::split(const NodePointer &node, unsigned int count) {
+  if (node == nullptr) {
+    return {nullptr, nullptr};
+  }
+  // Copy only the nodes along the cut; untouched subtrees are shared
+  unsigned int left_size = size(node->left);
+  if (count <= left_size) {
+    std::pair<NodePointer, NodePointer> halves = split(node->left, count);
+    return {halves.first,
+            make(node->data, node->priority, halves.second, node->right)};
+  }
+  std::pair<NodePointer, NodePointer> halves =
+      split(node->right, count - left_size - 1);
+  return {make(node->data, node->priority, node->left, halves.first),
+          halves.second};
+}
+
+template <typename T>
+typename PersistentLinkedList<T>::NodePointer
+PersistentLinkedList<T>::merge(const NodePointer &left,
+                               const NodePointer &right) {
+  if (left == nullptr) {
+    return right;
+  }
+  if (right == nullptr) {
+    return left;
+  }
+  if (left->priority > right->priority) {
+    return make(left->data, left->priority, left->left,
+                merge(left->right, right));
+  }
+  return make(right->data, right->priority, merge(left, right->left),
+              right->right);
+}
+
+template <typename T>
+const typename PersistentLinkedList<T>::Node *
+PersistentLinkedList<T>::select(const Node *node, unsigned int index) {
+  for (;;) {
+    unsigned int left_size = size(node->left);
+    if (index < left_size) {
+      node = node->left.get();
+    } else if (index == left_size) {
+      return node;
+    } else {
+      index -= left_size + 1;
+      node = node->right.get();
+    }
+  }
+}
+
+template <typename T> unsigned int PersistentLinkedList<T>::next_priority() {
+  _priority ^= _priority << 13; // xorshift32
+  _priority ^= _priority >> 17;
+  _priority ^= _priority << 5;
+  return _priority;
+}
+
+template <typename T> void PersistentLinkedList<T>::publish(NodePointer root) {
+  _root.Store(std::move(root));
+}
+
+template <typename T>
+unsigned int PersistentLinkedList<T>::Version::NodeCount() const {
+  return PersistentLinkedList::size(_root);
+}
+
+template <typename T>
+const T *PersistentLinkedList<T>::Version::Find(const T &data) const {
+  for (const_iterator it = begin(); it != end(); ++it) {
+    if (*it == data) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T>
+void PersistentLinkedList<T>::Version::PrintForward() const {
+  for (const T &element : *this) {
+    std::cout << element << '\n';
+  }
+  std::cout.flush();
+}
+
+template <typename T>
+typename PersistentLinkedList<T>::Version::const_iterator
+PersistentLinkedList<T>::Version::begin() const {
+  return const_iterator(_root.get());
+}
+
+template <typename T>
+typename PersistentLinkedList<T>::Version::const_iterator
+PersistentLinkedList<T>::Version::end() const {
+  return const_iterator();
+}
+
+template <typename T>
+const T &
+PersistentLinkedList<T>::Version::operator[](unsigned int index) const {
+  if (index >= NodeCount()) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  return PersistentLinkedList::select(_root.get(), index)->data;
+}
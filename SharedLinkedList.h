@@ -0,0 +1,133 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "AtomicSharedPtr.h"
+#include "LinkedList.h"
+
+// Thread-safe LinkedList for read-mostly workloads, using read-copy-update.
+// The current list is an immutable snapshot held by a shared_ptr. Readers
+// atomically load it (see AtomicSharedPtr; the load is brief but not
+// lock-free) and then traverse it with no synchronisation at all, so any
+// number of Find/FindAll/operator[]/PrintForward calls run in parallel and
+// never wait for a writer's copy. Writers serialise on _write_lock, apply
+// their change to a private copy and publish it with a single atomic store;
+// readers still holding the previous snapshot finish on it undisturbed, and it
+// is freed when the last of them lets go.
+//
+// Node pointers obtained from a snapshot stay valid for as long as that
+// snapshot is held. Use Update() to batch several mutations into one copy.
+template <typename T> class SharedLinkedList {
+public:
+  using Snapshot = std::shared_ptr<const LinkedList<T>>;
+
+  // Construction
+  SharedLinkedList();                                // Default constructor
+  explicit SharedLinkedList(const LinkedList<T> &list); // Start from a copy
+  SharedLinkedList(const SharedLinkedList &) = delete;
+  SharedLinkedList &operator=(const SharedLinkedList &) = delete;
+
+  // Readers (never wait for a writer's copy or mutation)
+  Snapshot Read() const;          // Current immutable version of the list
+  unsigned int NodeCount() const; // Size of the current version
+  bool Contains(const T &data) const; // Whether any node holds data
+  T At(unsigned int index) const; // Copy of the nth value; throws if absent
+  void PrintForward() const;      // Print current version in order
+  void PrintReverse() const;      // Print current version in reverse
+
+  // Writers (serialised among themselves)
+  template <typename Mutator>
+  void Update(Mutator mutate); // Run mutate(LinkedList<T>&) on a copy and
+                               // publish the result
+  void AddHead(const T &data); // Create new node at front of list
+  void AddTail(const T &data); // Create new node at end of list
+  void InsertAt(const T &data,
+                unsigned int index);  // Insert node at given index
+  unsigned int Remove(const T &data); // Delete all nodes containing data
+  bool RemoveAt(unsigned int index);  // Delete node at index
+  void Clear();                       // Publish an empty list
+
+private:
+  // Member variables
+  AtomicSharedPtr<const LinkedList<T>> _current; // Published version
+  std::mutex _write_lock; // Serialises writers
+};
+
+template <typename T>
+SharedLinkedList<T>::SharedLinkedList()
+    : _current(std::make_shared<const LinkedList<T>>()) {}
+
+template <typename T>
+SharedLinkedList<T>::SharedLinkedList(const LinkedList<T> &list)
+    : _current(std::make_shared<const LinkedList<T>>(list)) {}
+
+template <typename T>
+typename SharedLinkedList<T>::Snapshot SharedLinkedList<T>::Read() const {
+  return _current.Load();
+}
+
+template <typename T> unsigned int SharedLinkedList<T>::NodeCount() const {
+  return Read()->NodeCount();
+}
+
+template <typename T>
+bool SharedLinkedList<T>::Contains(const T &data) const {
+  return Read()->Find(data) != nullptr;
+}
+
+template <typename T> T SharedLinkedList<T>::At(unsigned int index) const {
+  Snapshot snapshot = Read(); // Keeps the node alive while it is copied
+  return (*snapshot)[index];
+}
+
+template <typename T> void SharedLinkedList<T>::PrintForward() const {
+  Read()->PrintForward();
+}
+
+template <typename T> void SharedLinkedList<T>::PrintReverse() const {
+  Read()->PrintReverse();
+}
+
+template <typename T>
+template <typename Mutator>
+void SharedLinkedList<T>::Update(Mutator mutate) {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  // Readers keep traversing the old version while the copy is made and
+  // changed; they only ever see complete versions
+  auto next = std::make_shared<LinkedList<T>>(*_current.Load());
+  mutate(*next);
+  _current.Store(std::move(next));
+}
+
+template <typename T> void SharedLinkedList<T>::AddHead(const T &data) {
+  Update([&data](LinkedList<T> &list) { list.AddHead(data); });
+}
+
+template <typename T> void SharedLinkedList<T>::AddTail(const T &data) {
+  Update([&data](LinkedList<T> &list) { list.AddTail(data); });
+}
+
+template <typename T>
+void SharedLinkedList<T>::InsertAt(const T &data, unsigned int index) {
+  Update([&](LinkedList<T> &list) { list.InsertAt(data, index); });
+}
+
+template <typename T>
+unsigned int SharedLinkedList<T>::Remove(const T &data) {
+  unsigned int removed = 0;
+  Update([&](LinkedList<T> &list) { removed = list.Remove(data); });
+  return removed;
+}
+
+template <typename T> bool SharedLinkedList<T>::RemoveAt(unsigned int index) {
+  bool removed = false;
+  Update([&](LinkedList<T> &list) { removed = list.RemoveAt(index); });
+  return removed;
+}
+
+template <typename T> void SharedLinkedList<T>::Clear() {
+  std::lock_guard<std::mutex> guard(_write_lock);
+  _current.Store(std::make_shared<LinkedList<T>>());
+}
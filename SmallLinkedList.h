@@ -0,0 +1,392 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "LinkedList.h"
+
+// Fixed block of N node-sized slots stored in place. Slots are handed out
+// first by bumping _carved and then from an intrusive free list of released
+// slots; once all N are in use Allocate() returns nullptr and the caller falls
+// back to the heap.
+template <typename T, unsigned int N> class InlineNodeArena {
+  static_assert(N > 0, "InlineNodeArena needs at least one slot");
+
+public:
+  // Construction
+  InlineNodeArena(); // Every slot starts out uncarved
+  InlineNodeArena(const InlineNodeArena &) = delete;
+  InlineNodeArena &operator=(const InlineNodeArena &) = delete;
+
+  // Behaviors
+  void *Allocate();            // Hand out a free slot, nullptr if none left
+  void Deallocate(void *slot); // Give a slot back to the free list
+
+  // Accessors
+  bool Owns(const void *pointer) const; // Whether pointer is one of our slots
+  unsigned int InUse() const;           // Number of slots handed out
+  static bool Fits(std::size_t size,
+                   std::size_t align); // Whether an object fits in a slot
+
+private:
+  // Same layout as LinkedList<T, ...>::Node, which is what the slots hold
+  struct Slot {
+    T data;
+    void *next;
+    void *prev;
+  };
+  struct FreeSlot {
+    FreeSlot *next; // Next free slot; overlays the released node's storage
+  };
+
+  // Member variables
+  alignas(Slot) unsigned char _storage[N * sizeof(Slot)]; // The N slots
+  FreeSlot *_free;      // Top of the free list of released slots
+  unsigned int _carved; // Slots handed out at least once
+  unsigned int _in_use; // Slots currently handed out
+};
+
+// Standard allocator that takes nodes from an InlineNodeArena while it has
+// room and from the heap after that. Allocators only compare equal when they
+// share an arena, and never propagate, so lists using different arenas move
+// payloads between each other instead of relinking nodes. A container copied
+// from one gets a heap-only allocator, as the arena belongs to the original.
+template <typename T, typename Arena> class InlineNodeAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  // Construction
+  InlineNodeAllocator() noexcept; // No arena; every node comes from the heap
+  explicit InlineNodeAllocator(Arena *arena) noexcept; // Serve from arena
+  template <typename U>
+  InlineNodeAllocator(
+      const InlineNodeAllocator<U, Arena> &other) noexcept; // Shares arena
+
+  // Behaviors
+  T *allocate(std::size_t n);
+  void deallocate(T *p, std::size_t n);
+  InlineNodeAllocator
+  select_on_container_copy_construction() const; // Heap-only allocator
+
+  // Accessors
+  Arena *arena() const; // The arena tried first, or nullptr
+
+private:
+  Arena *_arena; // Inline slots tried before the heap
+};
+
+template <typename T, typename U, typename Arena>
+bool operator==(const InlineNodeAllocator<T, Arena> &lhs,
+                const InlineNodeAllocator<U, Arena> &rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U, typename Arena>
+bool operator!=(const InlineNodeAllocator<T, Arena> &lhs,
+                const InlineNodeAllocator<U, Arena> &rhs) {
+  return !(lhs == rhs);
+}
+
+// LinkedList that keeps its first N nodes inside the list object itself, so
+// short lists are created, filled and destroyed without touching the heap.
+// Nodes beyond the first N come from the heap as usual, and inline slots are
+// reused as soon as they are released.
+//
+// Because inline nodes live in the object, moving a SmallLinkedList moves
+// payloads rather than stealing nodes, and splicing between two of them moves
+// payloads as well (see LinkedList::Splice).
+//
+// The LinkedList base is private so that no caller can get a mutable
+// LinkedList reference to the object: moving from one would steal nodes that
+// still live in this object's slots, and a reclaimer or allocator copy could
+// release or hand out inline nodes after the object is gone. The LinkedList
+// API is re-exported below, with list-taking members accepting
+// SmallLinkedList. List() gives read-only access where a LinkedList is needed.
+template <typename T, unsigned int N = 8>
+class SmallLinkedList
+    : private InlineNodeArena<T, N>,
+      private LinkedList<T, InlineNodeAllocator<T, InlineNodeArena<T, N>>> {
+  using Arena = InlineNodeArena<T, N>;
+  using Base = LinkedList<T, InlineNodeAllocator<T, Arena>>;
+
+public:
+  using Node = typename Base::Node;
+  using value_type = typename Base::value_type;
+  using size_type = typename Base::size_type;
+  using reference = typename Base::reference;
+  using const_reference = typename Base::const_reference;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+  using reverse_iterator = typename Base::reverse_iterator;
+  using const_reverse_iterator = typename Base::const_reverse_iterator;
+
+  // Construction
+  SmallLinkedList();                            // Default constructor
+  SmallLinkedList(const SmallLinkedList &list); // Copy constructor
+  SmallLinkedList(SmallLinkedList &&list);      // Move constructor
+  SmallLinkedList &operator=(const SmallLinkedList &rhs); // Copy assignment
+  SmallLinkedList &operator=(SmallLinkedList &&rhs);      // Move assignment
+
+  // Behaviors
+  using Base::PrintForward;
+  using Base::PrintForwardRecursive;
+  using Base::PrintReverse;
+  using Base::PrintReverseRecursive;
+  using Base::WriteReverseTo;
+  using Base::WriteTo;
+
+  // Accessors
+  static constexpr unsigned int InlineCapacity() { return N; }
+  unsigned int InlineNodeCount() const; // Nodes held in the inline slots
+  const Base &List() const; // Read-only view for code taking a LinkedList
+  using Base::Find;
+  using Base::FindAll;
+  using Base::GetNode;
+  using Base::Head;
+  using Base::NodeCount;
+  using Base::Tail;
+
+  // Iteration
+  using Base::begin;
+  using Base::cbegin;
+  using Base::cend;
+  using Base::crbegin;
+  using Base::crend;
+  using Base::end;
+  using Base::IteratorTo;
+  using Base::rbegin;
+  using Base::rend;
+
+  // Insertion
+  using Base::AddHead;
+  using Base::AddNodesHead;
+  using Base::AddNodesTail;
+  using Base::AddTail;
+  using Base::EmplaceAfter;
+  using Base::EmplaceBefore;
+  using Base::EmplaceHead;
+  using Base::EmplaceTail;
+  using Base::InsertAfter;
+  using Base::InsertAt;
+  using Base::InsertBefore;
+
+  // Removal
+  using Base::Clear;
+  using Base::Remove;
+  using Base::RemoveAt;
+  using Base::RemoveHead;
+  using Base::RemoveIf;
+  using Base::RemoveNode;
+  using Base::RemoveTail;
+
+  // Relinking (between two SmallLinkedLists this moves payloads)
+  void Splice(Node *position,
+              SmallLinkedList &other); // Move all of other before position
+                                       // (nullptr = end)
+  void Splice(Node *position, SmallLinkedList &other,
+              Node *node); // Move node out of other before position
+  void Splice(Node *position, SmallLinkedList &other, Node *first,
+              Node *last); // Move other's nodes first..last (inclusive)
+  SmallLinkedList SplitAfter(Node *node); // Detach nodes after node into a
+                                          // new list
+  void Append(SmallLinkedList &&other); // Move all of other to end
+  using Base::Compact;
+
+  // Ordering
+  using Base::InsertSorted;
+  using Base::Sort;
+  void Merge(SmallLinkedList &&other); // Merge sorted other into list
+  template <typename Compare>
+  void Merge(SmallLinkedList &&other,
+             Compare comp); // Merge sorted other using comp
+
+  // Operators
+  using Base::operator[];
+  bool operator==(const SmallLinkedList &rhs) const; // Equality operator
+};
+
+template <typename T, unsigned int N> InlineNodeArena<T, N>::InlineNodeArena() {
+  _free = nullptr;
+  _carved = 0;
+  _in_use = 0;
+}
+
+template <typename T, unsigned int N> void *InlineNodeArena<T, N>::Allocate() {
+  void *slot;
+  if (_free != nullptr) {
+    slot = _free;
+    _free = _free->next;
+  } else if (_carved < N) {
+    slot = _storage + _carved++ * sizeof(Slot); // No setup needed up front
+  } else {
+    return nullptr;
+  }
+  _in_use++;
+  return slot;
+}
+
+template <typename T, unsigned int N>
+void InlineNodeArena<T, N>::Deallocate(void *slot) {
+  FreeSlot *freed = static_cast<FreeSlot *>(slot);
+  freed->next = _free;
+  _free = freed;
+  _in_use--;
+}
+
+template <typename T, unsigned int N>
+bool InlineNodeArena<T, N>::Owns(const void *pointer) const {
+  std::less_equal<const void *> at_or_before;
+  return at_or_before(static_cast<const void *>(_storage), pointer) &&
+         std::less<const void *>()(pointer, _storage + sizeof(_storage));
+}
+
+template <typename T, unsigned int N>
+unsigned int InlineNodeArena<T, N>::InUse() const {
+  return _in_use;
+}
+
+template <typename T, unsigned int N>
+bool InlineNodeArena<T, N>::Fits(std::size_t size, std::size_t align) {
+  return size <= sizeof(Slot) && align <= alignof(Slot) &&
+         sizeof(FreeSlot) <= sizeof(Slot);
+}
+
+template <typename T, typename Arena>
+InlineNodeAllocator<T, Arena>::InlineNodeAllocator() noexcept
+    : _arena(nullptr) {}
+
+template <typename T, typename Arena>
+InlineNodeAllocator<T, Arena>::InlineNodeAllocator(Arena *arena) noexcept
+    : _arena(arena) {}
+
+template <typename T, typename Arena>
+template <typename U>
+InlineNodeAllocator<T, Arena>::InlineNodeAllocator(
+    const InlineNodeAllocator<U, Arena> &other) noexcept
+    : _arena(other.arena()) {}
+
+template <typename T, typename Arena>
+T *InlineNodeAllocator<T, Arena>::allocate(std::size_t n) {
+  if (_arena != nullptr && n == 1 && Arena::Fits(sizeof(T), alignof(T))) {
+    void *slot = _arena->Allocate();
+    if (slot != nullptr) {
+      return static_cast<T *>(slot);
+    }
+  }
+  return std::allocator<T>().allocate(n);
+}
+
+template <typename T, typename Arena>
+void InlineNodeAllocator<T, Arena>::deallocate(T *p, std::size_t n) {
+  if (_arena != nullptr && _arena->Owns(p)) {
+    _arena->Deallocate(p);
+    return;
+  }
+  std::allocator<T>().deallocate(p, n);
+}
+
+template <typename T, typename Arena>
+InlineNodeAllocator<T, Arena>
+InlineNodeAllocator<T, Arena>::select_on_container_copy_construction() const {
+  return InlineNodeAllocator(); // The copy must not share our owner's arena
+}
+
+template <typename T, typename Arena>
+Arena *InlineNodeAllocator<T, Arena>::arena() const {
+  return _arena;
+}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N>::SmallLinkedList()
+    : Arena(), Base(InlineNodeAllocator<T, Arena>(this)) {}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N>::SmallLinkedList(const SmallLinkedList &list)
+    : Arena(), Base(InlineNodeAllocator<T, Arena>(this)) {
+  Base::operator=(list); // Nodes come from our own arena, not list's
+}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N>::SmallLinkedList(SmallLinkedList &&list)
+    : Arena(), Base(InlineNodeAllocator<T, Arena>(this)) {
+  Base::operator=(std::move(list)); // Allocators differ, so payloads move
+}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N> &
+SmallLinkedList<T, N>::operator=(const SmallLinkedList &rhs) {
+  Base::operator=(rhs);
+  return *this;
+}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N> &SmallLinkedList<T, N>::operator=(SmallLinkedList &&rhs) {
+  Base::operator=(std::move(rhs));
+  return *this;
+}
+
+template <typename T, unsigned int N>
+void SmallLinkedList<T, N>::Splice(Node *position, SmallLinkedList &other) {
+  Base::Splice(position, other);
+}
+
+template <typename T, unsigned int N>
+void SmallLinkedList<T, N>::Splice(Node *position, SmallLinkedList &other,
+                                   Node *node) {
+  Base::Splice(position, other, node);
+}
+
+template <typename T, unsigned int N>
+void SmallLinkedList<T, N>::Splice(Node *position, SmallLinkedList &other,
+                                   Node *first, Node *last) {
+  Base::Splice(position, other, first, last);
+}
+
+template <typename T, unsigned int N>
+SmallLinkedList<T, N> SmallLinkedList<T, N>::SplitAfter(Node *node) {
+  // Base::SplitAfter would hand back nodes still living in our arena
+  SmallLinkedList rest;
+  if (node->next != nullptr) {
+    rest.Splice(nullptr, *this, node->next, this->Tail());
+  }
+  return rest;
+}
+
+template <typename T, unsigned int N>
+void SmallLinkedList<T, N>::Append(SmallLinkedList &&other) {
+  Base::Append(std::move(other));
+}
+
+template <typename T, unsigned int N>
+void SmallLinkedList<T, N>::Merge(SmallLinkedList &&other) {
+  Base::Merge(std::move(other));
+}
+
+template <typename T, unsigned int N>
+template <typename Compare>
+void SmallLinkedList<T, N>::Merge(SmallLinkedList &&other, Compare comp) {
+  Base::Merge(std::move(other), comp);
+}
+
+template <typename T, unsigned int N>
+bool SmallLinkedList<T, N>::operator==(const SmallLinkedList &rhs) const {
+  return Base::operator==(rhs);
+}
+
+template <typename T, unsigned int N>
+unsigned int SmallLinkedList<T, N>::InlineNodeCount() const {
+  return Arena::InUse();
+}
+
+template <typename T, unsigned int N>
+const typename SmallLinkedList<T, N>::Base &
+SmallLinkedList<T, N>::List() const {
+  return *this;
+}
@@ -0,0 +1,526 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Unrolled doubly-linked list. Each chunk stores up to N elements in a
+// fixed-capacity array, so traversals walk mostly contiguous memory and the
+// per-element pointer overhead is divided by N. Chunks split when an insert
+// lands in a full chunk and merge with a neighbour once they become sparse.
+template <typename T, unsigned int N = 16> class UnrolledLinkedList {
+  static_assert(N >= 2, "UnrolledLinkedList needs at least two slots a chunk");
+
+public:
+  struct Chunk; // Declaration of nested Chunk struct
+
+  // Construction / destruction
+  UnrolledLinkedList();                               // Default constructor
+  UnrolledLinkedList(const UnrolledLinkedList &list); // Copy constructor
+  ~UnrolledLinkedList();                              // Destructor
+
+  // Behaviors
+  void PrintForward() const; // Print all list items in order
+  void PrintReverse() const; // Print all list items in reverse
+
+  // Accessors
+  unsigned int NodeCount() const;  // Returns _size
+  unsigned int ChunkCount() const; // Returns number of allocated chunks
+  void FindAll(std::vector<const T *> &outData, const T &value)
+      const; // Returns a vector with all elements equal to value
+  const T *Find(const T &data) const; // Returns first element equal to data
+  T *Find(const T &data);             // Returns first element equal to data
+
+  // Insertion
+  void AddHead(const T &data); // Insert element at front of list
+  void AddTail(const T &data); // Insert element at end of list
+  void AddNodesHead(const T *data,
+                    unsigned int count); // Given array, insert at front
+  void AddNodesTail(const T *data,
+                    unsigned int count); // Given array, insert at end
+  void InsertAt(const T &data,
+                unsigned int index); // Insert element at given index
+
+  // Removal
+  bool RemoveHead();                  // Delete current head from list
+  bool RemoveTail();                  // Delete current tail from list
+  unsigned int Remove(const T &data); // Delete all elements equal to data
+  bool RemoveAt(unsigned int index);  // Delete element at index
+  void Clear();                       // Delete all elements in list
+
+  // Operators
+  const T &operator[](unsigned int index) const; // Subscript operator
+  T &operator[](unsigned int index);             // Subscript operator
+  bool operator==(const UnrolledLinkedList &rhs) const; // Equality operator
+  UnrolledLinkedList &
+  operator=(const UnrolledLinkedList &rhs); // Copy assignment operator
+
+private:
+  using Traits = std::allocator_traits<std::allocator<T>>;
+
+  // Member variables
+  Chunk *_head;             // Pointer to first chunk in list
+  Chunk *_tail;             // Pointer to last chunk in list
+  unsigned int _size;       // Number of elements in list
+  unsigned int _chunks;     // Number of chunks in list
+  std::allocator<T> _alloc; // Constructs elements inside chunk storage
+
+  // Private behaviors
+  Chunk *locate(unsigned int &index) const; // Chunk holding index; index
+                                            // becomes the offset inside it
+  Chunk *link_chunk_after(Chunk *chunk); // New empty chunk after chunk
+                                         // (nullptr links it at the front)
+  void unlink_chunk(Chunk *chunk);       // Unlink and free an empty chunk
+  void insert_into(Chunk *chunk, unsigned int offset, const T &data);
+  void erase_from(Chunk *chunk, unsigned int offset);
+  void split(Chunk *chunk);     // Move upper half into a new chunk
+  void rebalance(Chunk *chunk); // Merge chunk with a sparse neighbour
+  void merge_into(Chunk *left, Chunk *right); // Move right's items into left
+};
+
+// Nested Chunk struct for UnrolledLinkedList class
+template <typename T, unsigned int N> struct UnrolledLinkedList<T, N>::Chunk {
+  alignas(T) unsigned char storage[sizeof(T) * N]; // Raw storage for items
+  unsigned int count; // Number of constructed items at the front of storage
+  Chunk *next;        // Pointer to next chunk in list
+  Chunk *prev;        // Pointer to previous chunk in list
+
+  Chunk();                // Default constructor
+  T *items();             // Returns pointer to first item
+  const T *items() const; // Returns pointer to first item
+};
+
+template <typename T, unsigned int N> UnrolledLinkedList<T, N>::Chunk::Chunk() {
+  count = 0;
+  next = nullptr;
+  prev = nullptr;
+}
+
+template <typename T, unsigned int N>
+T *UnrolledLinkedList<T, N>::Chunk::items() {
+  return reinterpret_cast<T *>(storage);
+}
+
+template <typename T, unsigned int N>
+const T *UnrolledLinkedList<T, N>::Chunk::items() const {
+  return reinterpret_cast<const T *>(storage);
+}
+
+template <typename T, unsigned int N>
+UnrolledLinkedList<T, N>::UnrolledLinkedList() {
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _chunks = 0;
+}
+
+template <typename T, unsigned int N>
+UnrolledLinkedList<T, N>::UnrolledLinkedList(const UnrolledLinkedList &list) {
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _chunks = 0;
+  *this = list;
+}
+
+template <typename T, unsigned int N>
+UnrolledLinkedList<T, N>::~UnrolledLinkedList() {
+  Clear();
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::PrintForward() const {
+  for (const Chunk *chunk = _head; chunk != nullptr; chunk = chunk->next) {
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      std::cout << chunk->items()[i] << std::endl;
+    }
+  }
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::PrintReverse() const {
+  for (const Chunk *chunk = _tail; chunk != nullptr; chunk = chunk->prev) {
+    for (unsigned int i = chunk->count; i > 0; i--) {
+      std::cout << chunk->items()[i - 1] << std::endl;
+    }
+  }
+}
+
+template <typename T, unsigned int N>
+unsigned int UnrolledLinkedList<T, N>::NodeCount() const {
+  return _size;
+}
+
+template <typename T, unsigned int N>
+unsigned int UnrolledLinkedList<T, N>::ChunkCount() const {
+  return _chunks;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::FindAll(std::vector<const T *> &outData,
+                                       const T &value) const {
+  for (const Chunk *chunk = _head; chunk != nullptr; chunk = chunk->next) {
+    const T *items = chunk->items();
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      if (items[i] == value) {
+        outData.push_back(items + i);
+      }
+    }
+  }
+}
+
+template <typename T, unsigned int N>
+const T *UnrolledLinkedList<T, N>::Find(const T &data) const {
+  for (const Chunk *chunk = _head; chunk != nullptr; chunk = chunk->next) {
+    const T *items = chunk->items();
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      if (items[i] == data) {
+        return items + i;
+      }
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, unsigned int N>
+T *UnrolledLinkedList<T, N>::Find(const T &data) {
+  return const_cast<T *>(
+      static_cast<const UnrolledLinkedList *>(this)->Find(data));
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::AddHead(const T &data) {
+  if (_head == nullptr || _head->count == N) {
+    link_chunk_after(nullptr); // Start a fresh chunk instead of shifting a
+                               // full one
+  }
+  insert_into(_head, 0, data);
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::AddTail(const T &data) {
+  if (_tail == nullptr || _tail->count == N) {
+    link_chunk_after(_tail);
+  }
+  insert_into(_tail, _tail->count, data);
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::AddNodesHead(const T *data,
+                                            unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddHead(data[count - i - 1]); // To preserve the order of the array, start
+                                  // by adding the nth element and counting down
+  }
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::AddNodesTail(const T *data,
+                                            unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    AddTail(data[i]);
+  }
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::InsertAt(const T &data, unsigned int index) {
+  if (index > _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  } else if (index == _size) {
+    AddTail(data);
+    return;
+  }
+
+  Chunk *chunk = locate(index);
+  if (chunk->count == N) {
+    split(chunk);
+    if (index > chunk->count) {
+      index -= chunk->count;
+      chunk = chunk->next;
+    }
+  }
+  insert_into(chunk, index, data);
+}
+
+template <typename T, unsigned int N>
+bool UnrolledLinkedList<T, N>::RemoveHead() {
+  if (_head == nullptr) {
+    return false;
+  }
+  Chunk *chunk = _head;
+  erase_from(chunk, 0);
+  rebalance(chunk);
+  return true;
+}
+
+template <typename T, unsigned int N>
+bool UnrolledLinkedList<T, N>::RemoveTail() {
+  if (_tail == nullptr) {
+    return false;
+  }
+  Chunk *chunk = _tail;
+  erase_from(chunk, chunk->count - 1);
+  rebalance(chunk);
+  return true;
+}
+
+template <typename T, unsigned int N>
+unsigned int UnrolledLinkedList<T, N>::Remove(const T &data) {
+  const T value(data); // data may be an element that compaction overwrites
+  unsigned int removed = 0;
+  Chunk *chunk = _head;
+  while (chunk != nullptr) {
+    // Compact the survivors of this chunk towards its front in one pass
+    T *items = chunk->items();
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      if (items[i] == value) {
+        continue;
+      }
+      if (kept != i) {
+        items[kept] = std::move(items[i]);
+      }
+      kept++;
+    }
+    for (unsigned int i = kept; i < chunk->count; i++) {
+      Traits::destroy(_alloc, items + i);
+    }
+    removed += chunk->count - kept;
+    _size -= chunk->count - kept;
+    chunk->count = kept;
+
+    Chunk *next = chunk->next;
+    if (chunk->count == 0) {
+      unlink_chunk(chunk);
+    } else if (chunk->prev != nullptr &&
+               chunk->prev->count + chunk->count <= N) {
+      merge_into(chunk->prev, chunk);
+    }
+    chunk = next;
+  }
+  return removed;
+}
+
+template <typename T, unsigned int N>
+bool UnrolledLinkedList<T, N>::RemoveAt(unsigned int index) {
+  if (index >= _size) {
+    std::cerr << "Error: Index out of range." << '\n';
+    return false;
+  }
+  Chunk *chunk = locate(index);
+  erase_from(chunk, index);
+  rebalance(chunk);
+  return true;
+}
+
+template <typename T, unsigned int N> void UnrolledLinkedList<T, N>::Clear() {
+  Chunk *chunk = _head;
+  while (chunk != nullptr) {
+    Chunk *next = chunk->next;
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      Traits::destroy(_alloc, chunk->items() + i);
+    }
+    delete chunk;
+    chunk = next;
+  }
+  _head = nullptr;
+  _tail = nullptr;
+  _size = 0;
+  _chunks = 0;
+}
+
+template <typename T, unsigned int N>
+const T &UnrolledLinkedList<T, N>::operator[](unsigned int index) const {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  Chunk *chunk = locate(index);
+  return chunk->items()[index];
+}
+
+template <typename T, unsigned int N>
+T &UnrolledLinkedList<T, N>::operator[](unsigned int index) {
+  if (index >= _size) {
+    throw std::out_of_range("Error: Index out of range.");
+  }
+  Chunk *chunk = locate(index);
+  return chunk->items()[index];
+}
+
+template <typename T, unsigned int N>
+bool UnrolledLinkedList<T, N>::operator==(
+    const UnrolledLinkedList &rhs) const {
+  if (_size != rhs._size) {
+    return false;
+  }
+
+  // Chunk boundaries differ between equal lists, so walk both with cursors
+  const Chunk *lhs_chunk = _head;
+  const Chunk *rhs_chunk = rhs._head;
+  unsigned int lhs_offset = 0;
+  unsigned int rhs_offset = 0;
+  for (unsigned int item = 0; item < _size; item++) {
+    if (lhs_offset == lhs_chunk->count) {
+      lhs_chunk = lhs_chunk->next;
+      lhs_offset = 0;
+    }
+    if (rhs_offset == rhs_chunk->count) {
+      rhs_chunk = rhs_chunk->next;
+      rhs_offset = 0;
+    }
+    if (lhs_chunk->items()[lhs_offset] != rhs_chunk->items()[rhs_offset]) {
+      return false;
+    }
+    lhs_offset++;
+    rhs_offset++;
+  }
+  return true;
+}
+
+template <typename T, unsigned int N>
+UnrolledLinkedList<T, N> &
+UnrolledLinkedList<T, N>::operator=(const UnrolledLinkedList &rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  Clear();
+  for (const Chunk *chunk = rhs._head; chunk != nullptr; chunk = chunk->next) {
+    Chunk *copy = link_chunk_after(_tail); // Keep rhs's chunk layout
+    for (unsigned int i = 0; i < chunk->count; i++) {
+      Traits::construct(_alloc, copy->items() + i, chunk->items()[i]);
+      copy->count++;
+      _size++;
+    }
+  }
+  return *this;
+}
+
+template <typename T, unsigned int N>
+typename UnrolledLinkedList<T, N>::Chunk *
+UnrolledLinkedList<T, N>::locate(unsigned int &index) const {
+  if (index >= _size / 2) {
+    // Closer to the tail; count back from the end
+    unsigned int remaining = _size - index;
+    Chunk *chunk = _tail;
+    while (remaining > chunk->count) {
+      remaining -= chunk->count;
+      chunk = chunk->prev;
+    }
+    index = chunk->count - remaining;
+    return chunk;
+  }
+  Chunk *chunk = _head;
+  while (index >= chunk->count) {
+    index -= chunk->count;
+    chunk = chunk->next;
+  }
+  return chunk;
+}
+
+template <typename T, unsigned int N>
+typename UnrolledLinkedList<T, N>::Chunk *
+UnrolledLinkedList<T, N>::link_chunk_after(Chunk *chunk) {
+  Chunk *new_chunk = new Chunk();
+  new_chunk->prev = chunk;
+  new_chunk->next = chunk == nullptr ? _head : chunk->next;
+  if (new_chunk->next != nullptr) {
+    new_chunk->next->prev = new_chunk;
+  } else {
+    _tail = new_chunk;
+  }
+  if (chunk != nullptr) {
+    chunk->next = new_chunk;
+  } else {
+    _head = new_chunk;
+  }
+  _chunks++;
+  return new_chunk;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::unlink_chunk(Chunk *chunk) {
+  if (chunk->prev != nullptr) {
+    chunk->prev->next = chunk->next;
+  } else {
+    _head = chunk->next;
+  }
+  if (chunk->next != nullptr) {
+    chunk->next->prev = chunk->prev;
+  } else {
+    _tail = chunk->prev;
+  }
+  delete chunk;
+  _chunks--;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::insert_into(Chunk *chunk, unsigned int offset,
+                                           const T &data) {
+  T *items = chunk->items();
+  if (offset == chunk->count) {
+    Traits::construct(_alloc, items + offset, data);
+  } else {
+    T copy(data); // data may alias an item about to be shifted
+    Traits::construct(_alloc, items + chunk->count,
+                      std::move(items[chunk->count - 1]));
+    std::move_backward(items + offset, items + chunk->count - 1,
+                       items + chunk->count);
+    items[offset] = std::move(copy);
+  }
+  chunk->count++;
+  _size++;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::erase_from(Chunk *chunk, unsigned int offset) {
+  T *items = chunk->items();
+  std::move(items + offset + 1, items + chunk->count, items + offset);
+  Traits::destroy(_alloc, items + chunk->count - 1);
+  chunk->count--;
+  _size--;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::split(Chunk *chunk) {
+  Chunk *upper = link_chunk_after(chunk);
+  unsigned int keep = chunk->count / 2;
+  T *items = chunk->items();
+  for (unsigned int i = keep; i < chunk->count; i++) {
+    Traits::construct(_alloc, upper->items() + upper->count,
+                      std::move(items[i]));
+    Traits::destroy(_alloc, items + i);
+    upper->count++;
+  }
+  chunk->count = keep;
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::rebalance(Chunk *chunk) {
+  if (chunk->count == 0) {
+    unlink_chunk(chunk);
+  } else if (chunk->count < N / 2) {
+    // Sparse chunk; fold it into whichever neighbour still has room
+    if (chunk->next != nullptr && chunk->count + chunk->next->count <= N) {
+      merge_into(chunk, chunk->next);
+    } else if (chunk->prev != nullptr &&
+               chunk->prev->count + chunk->count <= N) {
+      merge_into(chunk->prev, chunk);
+    }
+  }
+}
+
+template <typename T, unsigned int N>
+void UnrolledLinkedList<T, N>::merge_into(Chunk *left, Chunk *right) {
+  T *items = right->items();
+  for (unsigned int i = 0; i < right->count; i++) {
+    Traits::construct(_alloc, left->items() + left->count,
+                      std::move(items[i]));
+    Traits::destroy(_alloc, items + i);
+    left->count++;
+  }
+  right->count = 0;
+  unlink_chunk(right);
+}
@@ -0,0 +1,116 @@
+// Compares LinkedList's multi-cursor traversals (Find, FindAll, operator==)
+// against plain single-cursor walks on lists much larger than the last-level
+// cache, with nodes scattered so every hop is a cache miss. GetNode has only
+// one cursor; it is compared against a walk from the same end, so its row
+// shows what the prefetch hint adds on its own.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. bench/prefetch_bench.cpp -o prefetch_bench
+//   ./prefetch_bench [nodes]   (default 8M nodes, about 200 MB per list)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "LinkedList.h"
+
+using List = LinkedList<unsigned int>;
+using Node = List::Node;
+
+// Fill list with count random values, then sort it so traversal order no
+// longer follows allocation order
+static void build_scattered(List &list, unsigned int count, unsigned int seed) {
+  std::mt19937 rng(seed);
+  for (unsigned int i = 0; i < count; i++) {
+    list.AddTail(rng() | 1); // Odd values, so searching for 0 never matches
+  }
+  list.Sort();
+}
+
+template <typename Function> static double best_of(int runs, Function fn) {
+  double best = 1e30;
+  for (int run = 0; run < runs; run++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+static void report(const char *name, double baseline, double tuned) {
+  std::printf("%-10s single cursor %8.1f ms   LinkedList %8.1f ms   %.2fx\n",
+              name, baseline * 1e3, tuned * 1e3, baseline / tuned);
+}
+
+int main(int argc, char **argv) {
+  unsigned int count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1u << 23;
+  const int runs = 3;
+  List lhs;
+  List rhs;
+  build_scattered(lhs, count, 1);
+  build_scattered(rhs, count, 1);
+  std::printf("%u nodes per list\n", count);
+
+  const void *volatile sink = nullptr; // Keeps every result observable
+
+  // Find: miss, so the whole list is walked
+  double find_base = best_of(runs, [&] {
+    const Node *node = lhs.Head();
+    while (node != nullptr && node->data != 0) {
+      node = node->next;
+    }
+    sink = node;
+  });
+  double find_tuned = best_of(runs, [&] { sink = lhs.Find(0); });
+  report("Find", find_base, find_tuned);
+
+  // FindAll: every node is visited regardless
+  vector<Node *> found;
+  double all_base = best_of(runs, [&] {
+    found.clear();
+    for (Node *node = lhs.Head(); node != nullptr; node = node->next) {
+      if (node->data == 0) {
+        found.push_back(node);
+      }
+    }
+  });
+  double all_tuned = best_of(runs, [&] {
+    found.clear();
+    lhs.FindAll(found, 0);
+  });
+  report("FindAll", all_base, all_tuned);
+
+  // GetNode near the tail, against a walk that also starts from the nearer
+  // end: both make the same count / 8 hops, so this measures the prefetch
+  // hint alone, not the choice of end
+  unsigned int index = count - count / 8;
+  double get_base = best_of(runs, [&] {
+    const Node *node = lhs.Tail();
+    for (unsigned int i = count - 1; i > index; i--) {
+      node = node->prev;
+    }
+    sink = node;
+  });
+  double get_tuned = best_of(runs, [&] { sink = lhs.GetNode(index); });
+  report("GetNode", get_base, get_tuned);
+
+  // operator== on equal lists, so nothing short-circuits
+  volatile bool equal = false;
+  double eq_base = best_of(runs, [&] {
+    const Node *left = lhs.Head();
+    const Node *right = rhs.Head();
+    while (left != nullptr && left->data == right->data) {
+      left = left->next;
+      right = right->next;
+    }
+    equal = left == nullptr;
+  });
+  double eq_tuned = best_of(runs, [&] { equal = lhs == rhs; });
+  report("operator==", eq_base, eq_tuned);
+
+  return equal ? 0 : 1;
+}
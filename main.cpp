@@ -1,7 +1,27 @@
 #include <iostream>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include "LinkedList.h"
+#include "NodePool.h"
+#include "IndexedLinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "ConcurrentLinkedQueue.h"
+#include "HashedLinkedList.h"
+#include "FingerprintedLinkedList.h"
+#include "SharedLinkedList.h"
+#include "ParallelLinkedList.h"
+#include "IntrusiveLinkedList.h"
+#include "SmallLinkedList.h"
+#include "CompactLinkedList.h"
+#include "LinkedListSnapshot.h"
+#include "NodeReclaimer.h"
+#include "CowLinkedList.h"
 #include "leaker.h"
 using namespace std;
 
@@ -9,6 +29,30 @@ void TestRemove();
 void TestRemoveHeadTail();
 void TestOtherRemoval();
 void TestRecursion();
+void TestMovedFromPoolList();
+void TestMovedPoolAllocator();
+void TestIndexedRemoveAliased();
+void TestUnrolledRemoveAliased();
+void TestQueueBatchThrows();
+void TestIterators();
+void TestHashedDuplicates();
+void TestRemoveIf();
+void TestSpliceSplit();
+void TestSortMerge();
+void TestBulkAdd();
+void TestCopyReuse();
+void TestFingerprintCollision();
+void TestRemoveAtEnds();
+void TestParallelSerial();
+void TestIntrusiveList();
+void TestSmallListLifetime();
+void TestCompactList();
+void TestWriteTo();
+void TestSnapshots();
+void TestCompactStats();
+void TestTwoCursorSearch();
+void TestNodeReclaimer();
+void TestCowUnsharing();
 
 int main()
 {
@@ -22,6 +66,54 @@ int main()
       	TestOtherRemoval();
    else if (testNum == 4)
       	TestRecursion();
+   else if (testNum == 5)
+      	TestMovedFromPoolList();
+   else if (testNum == 6)
+      	TestMovedPoolAllocator();
+   else if (testNum == 7)
+      	TestIndexedRemoveAliased();
+   else if (testNum == 8)
+      	TestUnrolledRemoveAliased();
+   else if (testNum == 9)
+      	TestQueueBatchThrows();
+   else if (testNum == 10)
+      	TestIterators();
+   else if (testNum == 11)
+      	TestHashedDuplicates();
+   else if (testNum == 12)
+      	TestRemoveIf();
+   else if (testNum == 13)
+      	TestSpliceSplit();
+   else if (testNum == 14)
+      	TestSortMerge();
+   else if (testNum == 15)
+      	TestBulkAdd();
+   else if (testNum == 16)
+      	TestCopyReuse();
+   else if (testNum == 17)
+      	TestFingerprintCollision();
+   else if (testNum == 18)
+      	TestRemoveAtEnds();
+   else if (testNum == 19)
+      	TestParallelSerial();
+   else if (testNum == 20)
+      	TestIntrusiveList();
+   else if (testNum == 21)
+      	TestSmallListLifetime();
+   else if (testNum == 22)
+      	TestCompactList();
+   else if (testNum == 23)
+      	TestWriteTo();
+   else if (testNum == 24)
+      	TestSnapshots();
+   else if (testNum == 25)
+      	TestCompactStats();
+   else if (testNum == 26)
+      	TestTwoCursorSearch();
+   else if (testNum == 27)
+      	TestNodeReclaimer();
+   else if (testNum == 28)
+      	TestCowUnsharing();
       
 	return 0;
 }
@@ -142,4 +234,1039 @@ void TestRecursion()
 	cout << "Printing recursively in reverse from 512: " << endl;
 	node = power2.Find(512);
 	power2.PrintReverseRecursive(node);
-}
\ No newline at end of file
+}
+
+void TestMovedFromPoolList()
+{
+	cout << "=====Testing moved-from pooled lists=====" << endl;
+	LinkedList<int, PoolAllocator<int>> source;
+	source.AddTail(1);
+	source.AddTail(2);
+	LinkedList<int, PoolAllocator<int>> moved(std::move(source));
+	source.AddTail(3); // Must still have a pool to allocate from
+	LinkedList<int, PoolAllocator<int>> assigned;
+	assigned = std::move(moved);
+	moved.AddTail(4);
+	cout << "Source: ";
+	source.PrintForward();
+	cout << "Moved: ";
+	moved.PrintForward();
+	cout << "Assigned: ";
+	assigned.PrintForward();
+}
+
+void TestMovedPoolAllocator()
+{
+	cout << "=====Testing moved PoolAllocators=====" << endl;
+	PoolAllocator<int> original;
+	PoolAllocator<int> copy(original);
+	PoolAllocator<int> moved(std::move(copy));
+	cout << "Moved-from equals original: " << (copy == original ? "yes" : "no") << endl;
+	cout << "Moved equals original: " << (moved == original ? "yes" : "no") << endl;
+	PoolAllocator<int> assigned;
+	assigned = std::move(moved);
+	cout << "Move-assigned-from equals original: " << (moved == original ? "yes" : "no") << endl;
+	int *value = moved.allocate(1); // Moved-from allocators still allocate
+	*value = 42;
+	cout << "Allocated through moved-from allocator: " << *value << endl;
+	original.deallocate(value, 1);
+}
+
+void TestIndexedRemoveAliased()
+{
+	cout << "=====Testing IndexedLinkedList::Remove() with an element of the list=====" << endl;
+	IndexedLinkedList<string> data;
+	data.AddTail("a");
+	data.AddTail("x");
+	data.AddTail("b");
+	data.AddTail("x");
+	data.AddTail("x");
+	unsigned int removed = data.Remove(data[1]); // Argument lives in a removed node
+	cout << "Removed " << removed << " nodes" << endl;
+	data.PrintForward();
+}
+
+void TestUnrolledRemoveAliased()
+{
+	cout << "=====Testing UnrolledLinkedList::Remove() with an element of the list=====" << endl;
+	UnrolledLinkedList<string> data;
+	data.AddTail("a");
+	data.AddTail("x");
+	data.AddTail("b");
+	data.AddTail("x");
+	unsigned int removed = data.Remove(data[1]); // Compaction moves over data[1]
+	cout << "Removed " << removed << " nodes" << endl;
+	data.PrintForward();
+}
+
+// Output iterator whose third assignment throws
+struct ThrowingSink
+{
+	int* written;
+	ThrowingSink& operator*() { return *this; }
+	ThrowingSink& operator++() { return *this; }
+	ThrowingSink& operator=(int)
+	{
+		if (++*written == 3)
+			throw runtime_error("sink full");
+		return *this;
+	}
+};
+
+void TestQueueBatchThrows()
+{
+	cout << "=====Testing ConcurrentLinkedQueue::PopHeadBatch() with a throwing output=====" << endl;
+	ConcurrentLinkedQueue<int> queue;
+	for (int i = 0; i < 10; i++)
+		queue.PushTail(i);
+	int written = 0;
+	ThrowingSink sink = { &written };
+	try
+	{
+		queue.PopHeadBatch(sink, 10);
+		cout << "No exception thrown?" << endl;
+	}
+	catch (const runtime_error& e)
+	{
+		cout << "Caught: " << e.what() << endl;
+	}
+	cout << "Size after exception: " << queue.Size() << endl;
+	optional<int> next = queue.TryPopHead();
+	cout << "Next value: " << (next ? *next : -1) << endl;
+}
+
+void TestIterators()
+{
+	cout << "=====Testing LinkedList iterators=====" << endl;
+	LinkedList<int> empty;
+	cout << "Empty list begin == end: " << (empty.begin() == empty.end() ? "yes" : "no") << endl;
+
+	LinkedList<int> data;
+	for (int i = 1; i <= 5; i++)
+		data.AddTail(i * 10);
+	cout << "Range-for:";
+	for (int value : data)
+		cout << " " << value;
+	cout << endl;
+
+	for (int& value : data)
+		value += 1; // Writes go straight to the nodes
+	cout << "Reverse:";
+	for (auto it = data.rbegin(); it != data.rend(); ++it)
+		cout << " " << *it;
+	cout << endl;
+
+	LinkedList<int>::iterator last = data.end();
+	--last; // Stepping back from end() lands on the tail
+	cout << "Before end(): " << *last << endl;
+	LinkedList<int>::const_iterator converted = data.begin();
+	cout << "Converted const_iterator: " << *converted << endl;
+	cout << "std::distance: " << distance(data.cbegin(), data.cend()) << endl;
+	auto found = find(data.begin(), data.end(), 31);
+	cout << "std::find 31: " << (found != data.end() ? "found" : "missing") << endl;
+	cout << "IteratorTo(node 41) -> " << *data.IteratorTo(data.Find(41)) << ", next "
+		<< *++data.IteratorTo(data.Find(41)) << endl;
+	auto post = data.begin();
+	cout << "Post-increment returns " << *post++ << ", now at " << *post << endl;
+}
+
+void TestHashedDuplicates()
+{
+	cout << "=====Testing HashedLinkedList Find()/FindAll()/Remove() with duplicates=====" << endl;
+	HashedLinkedList<int> data;
+	int values[] = { 7, 3, 7, 9, 7, 3 };
+	data.AddNodesTail(values, 6);
+	cout << "Count(7): " << data.Count(7) << ", Count(3): " << data.Count(3)
+		<< ", Count(4): " << data.Count(4) << endl;
+	cout << "Find(4): " << (data.Find(4) == nullptr ? "nullptr" : "found") << endl;
+	vector<const HashedLinkedList<int>::Node*> found;
+	data.FindAll(found, 7);
+	bool allSeven = true;
+	for (const HashedLinkedList<int>::Node* node : found)
+		allSeven = allSeven && node->data == 7;
+	cout << "FindAll(-7): " << found.size() << " nodes, all 7: " << (allSeven ? "yes" : "no") << endl;
+
+	// The head's data backs the index key for 7; dropping it must rekey
+	data.RemoveHead();
+	cout << "After RemoveHead Count(7): " << data.Count(7) << ", Find(7) -> "
+		<< data.Find(7)->data << endl;
+	data.Set(data.GetNode(1), 3); // Moves a node from one group to another
+	cout << "After Set Count(7): " << data.Count(7) << ", Count(3): " << data.Count(3) << endl;
+	data.PrintForward();
+
+	cout << "Remove(3) removed " << data.Remove(3) << " nodes" << endl;
+	cout << "Remove(3) again removed " << data.Remove(3) << " nodes" << endl;
+	data.PrintForward();
+	data.RemoveAt(0);
+	cout << "Contains(9): " << (data.Contains(9) ? "yes" : "no") << ", Contains(7): "
+		<< (data.Contains(7) ? "yes" : "no") << endl;
+
+	HashedLinkedList<int> moved(std::move(data));
+	moved.AddTail(7);
+	cout << "Moved Count(7): " << moved.Count(7) << ", source nodes: " << data.NodeCount() << endl;
+}
+
+void TestRemoveIf()
+{
+	cout << "=====Testing RemoveIf() functionality=====" << endl;
+	LinkedList<int> data;
+	for (int i = 0; i < 10; i++)
+		data.AddTail(i);
+
+	// Matches at both ends and in the middle
+	unsigned int removed = data.RemoveIf([](const int& value) { return value % 3 == 0; });
+	cout << "Removed multiples of 3: " << removed << endl;
+	data.PrintForward();
+	cout << "Reverse (checks prev links and the tail):" << endl;
+	data.PrintReverse();
+	cout << "Head " << data.Head()->data << ", tail " << data.Tail()->data
+		<< ", count " << data.NodeCount() << endl;
+
+	removed = data.RemoveIf([](const int& value) { return value > 100; });
+	cout << "Removed nothing: " << removed << ", count " << data.NodeCount() << endl;
+
+	removed = data.RemoveIf([](const int&) { return true; });
+	cout << "Removed everything: " << removed << ", head is "
+		<< (data.Head() == nullptr && data.Tail() == nullptr ? "null" : "not null") << endl;
+	data.AddTail(5); // The emptied list must still accept nodes
+	data.AddTail(5);
+	data.AddTail(6);
+	removed = data.Remove(data[0]); // The argument lives in a matching node
+	cout << "Remove(data[0]) removed " << removed << endl;
+	data.PrintForward();
+}
+
+// Prints the list front to back and back to front on one line each, so a
+// broken prev link or a stale tail shows up as a mismatch
+template <typename List>
+void PrintBothWays(const List& data)
+{
+	cout << "[" << data.NodeCount() << "] forward:";
+	for (auto node = data.Head(); node != nullptr; node = node->next)
+		cout << " " << node->data;
+	cout << " | reverse:";
+	for (auto node = data.Tail(); node != nullptr; node = node->prev)
+		cout << " " << node->data;
+	cout << endl;
+}
+
+void TestSpliceSplit()
+{
+	cout << "=====Testing Splice(), SplitAfter() and Append()=====" << endl;
+	LinkedList<int> data;
+	LinkedList<int> other;
+	for (int i = 1; i <= 4; i++)
+	{
+		data.AddTail(i);
+		other.AddTail(i * 10);
+	}
+
+	// A partial range out of the middle of another list
+	data.Splice(data.Find(3), other, other.Find(20), other.Find(30));
+	cout << "Range 20..30 before 3: ";
+	PrintBothWays(data);
+	cout << "Other: ";
+	PrintBothWays(other);
+
+	// A single node within one list, moved to the front and to the end
+	data.Splice(data.Head(), data, data.Find(4));
+	data.Splice(nullptr, data, data.Find(1));
+	cout << "4 to front, 1 to end: ";
+	PrintBothWays(data);
+
+	// Everything in other, at the end
+	data.Splice(nullptr, other);
+	cout << "Whole of other at end: ";
+	PrintBothWays(data);
+	cout << "Other: ";
+	PrintBothWays(other);
+
+	LinkedList<int> rest = data.SplitAfter(data.Find(3));
+	cout << "SplitAfter(3) kept: ";
+	PrintBothWays(data);
+	cout << "SplitAfter(3) rest: ";
+	PrintBothWays(rest);
+	LinkedList<int> none = data.SplitAfter(data.Tail());
+	cout << "SplitAfter(tail) rest: ";
+	PrintBothWays(none);
+
+	data.Append(std::move(rest));
+	cout << "Append back: ";
+	PrintBothWays(data);
+
+	// Separate pools compare unequal, so the payloads are moved instead
+	LinkedList<int, PoolAllocator<int>> pooledA;
+	LinkedList<int, PoolAllocator<int>> pooledB;
+	pooledA.AddTail(1);
+	pooledA.AddTail(4);
+	pooledB.AddTail(2);
+	pooledB.AddTail(3);
+	pooledA.Splice(pooledA.Find(4), pooledB);
+	cout << "Across pools: ";
+	PrintBothWays(pooledA);
+	cout << "Source pool list: ";
+	PrintBothWays(pooledB);
+}
+
+// Orders by the tens digit only, so values with the same tens digit tie and
+// their original order shows whether a sort is stable. Throws on call
+// number throwAt (0 = never)
+struct TensLess
+{
+	int* calls;
+	int throwAt;
+	bool operator()(int lhs, int rhs) const
+	{
+		if (++*calls == throwAt)
+			throw runtime_error("comparator failed");
+		return lhs / 10 < rhs / 10;
+	}
+};
+
+void TestSortMerge()
+{
+	cout << "=====Testing Sort(), Merge() and InsertSorted()=====" << endl;
+	LinkedList<int> data;
+	int values[] = { 31, 12, 33, 11, 25, 32, 13, 24, 21, 34, 22, 14 };
+	for (int value : values)
+		data.AddTail(value);
+	int calls = 0;
+	data.Sort(TensLess{ &calls, 0 });
+	cout << "Stable sort by tens: ";
+	PrintBothWays(data);
+
+	LinkedList<int> other;
+	other.AddTail(15);
+	other.AddTail(26);
+	other.AddTail(40);
+	data.Merge(std::move(other), TensLess{ &calls, 0 });
+	cout << "Merge (ties stay behind this list's nodes): ";
+	PrintBothWays(data);
+	cout << "Merged-from list count: " << other.NodeCount() << endl;
+	data.InsertSorted(27, TensLess{ &calls, 0 });
+	data.InsertSorted(5, TensLess{ &calls, 0 });
+	data.InsertSorted(99, TensLess{ &calls, 0 });
+	cout << "InsertSorted 27, 5, 99: ";
+	PrintBothWays(data);
+
+	// A comparator that fails part way through a pass
+	LinkedList<int> big;
+	long long sum = 0;
+	for (int i = 0; i < 200; i++)
+	{
+		int value = (i * 37) % 200;
+		big.AddTail(value);
+		sum += value;
+	}
+	calls = 0;
+	try
+	{
+		big.Sort(TensLess{ &calls, 150 });
+		cout << "No exception thrown?" << endl;
+	}
+	catch (const runtime_error& e)
+	{
+		cout << "Caught: " << e.what() << " on call " << calls << endl;
+	}
+	unsigned int forward = 0;
+	unsigned int backward = 0;
+	long long seen = 0;
+	for (auto node = big.Head(); node != nullptr; node = node->next)
+	{
+		forward++;
+		seen += node->data;
+	}
+	for (auto node = big.Tail(); node != nullptr; node = node->prev)
+		backward++;
+	cout << "After exception: count " << big.NodeCount() << ", forward " << forward
+		<< ", backward " << backward << ", sum " << (seen == sum ? "matches" : "differs") << endl;
+	big.Sort(); // Still a usable list
+	bool sorted = true;
+	for (auto node = big.Head(); node->next != nullptr; node = node->next)
+		sorted = sorted && node->data <= node->next->data;
+	cout << "Sorted again: " << (sorted ? "yes" : "no") << endl;
+}
+
+// Copying the value marked fail throws, to interrupt a bulk insertion
+struct Fragile
+{
+	int value;
+	bool fail;
+	Fragile(int v, bool f = false) : value(v), fail(f) {}
+	Fragile(const Fragile& other) : value(other.value), fail(other.fail)
+	{
+		if (fail)
+			throw runtime_error("copy failed");
+	}
+};
+
+ostream& operator<<(ostream& os, const Fragile& item)
+{
+	return os << item.value;
+}
+
+void TestBulkAdd()
+{
+	cout << "=====Testing bulk AddNodesHead()/AddNodesTail()=====" << endl;
+	LinkedList<int> data;
+	int middle[] = { 4, 5, 6 };
+	data.AddNodesTail(middle, 3);
+	data.AddNodesHead({ 1, 2, 3 });
+	vector<int> tail = { 7, 8, 9 };
+	data.AddNodesTail(tail.begin(), tail.end());
+	cout << "Array, initializer_list and vector: ";
+	PrintBothWays(data);
+
+	stringstream input("10 11 12");
+	data.AddNodesTail(istream_iterator<int>(input), istream_iterator<int>());
+	data.AddNodesHead(middle, 0);
+	data.AddNodesTail(tail.end(), tail.end());
+	cout << "Single-pass input, then empty ranges: ";
+	PrintBothWays(data);
+
+	LinkedList<int> empty;
+	empty.AddNodesHead(middle, 3); // Head of an empty list
+	cout << "AddNodesHead into an empty list: ";
+	PrintBothWays(empty);
+
+	LinkedList<int, PoolAllocator<int>> pooled;
+	pooled.AddNodesTail(tail.begin(), tail.end());
+	pooled.AddNodesHead(middle, 3);
+	cout << "Pooled: ";
+	PrintBothWays(pooled);
+
+	// A failed copy must leave the list exactly as it was
+	LinkedList<Fragile> fragile;
+	fragile.AddTail(Fragile(1));
+	Fragile items[] = { Fragile(2), Fragile(3), Fragile(4, true), Fragile(5) };
+	try
+	{
+		fragile.AddNodesTail(items, 4);
+		cout << "No exception thrown?" << endl;
+	}
+	catch (const runtime_error& e)
+	{
+		cout << "Caught: " << e.what() << endl;
+	}
+	cout << "After failed bulk add: ";
+	PrintBothWays(fragile);
+}
+
+void TestCopyReuse()
+{
+	cout << "=====Testing copy construction and node-reusing copy assignment=====" << endl;
+	LinkedList<int> shortList;
+	LinkedList<int> longList;
+	for (int i = 1; i <= 3; i++)
+		shortList.AddTail(i);
+	for (int i = 10; i <= 70; i += 10)
+		longList.AddTail(i);
+
+	LinkedList<int> copy(longList);
+	cout << "Copy constructed: ";
+	PrintBothWays(copy);
+	cout << "Copy is " << (copy == longList ? "equal" : "not equal") << " and owns "
+		<< (copy.Head() != longList.Head() ? "its own nodes" : "shared nodes") << endl;
+
+	// Longer destination: leading nodes are reused, the rest are freed
+	const LinkedList<int>::Node* oldHead = copy.Head();
+	copy = shortList;
+	cout << "Assign shorter: ";
+	PrintBothWays(copy);
+	cout << "Head node reused: " << (copy.Head() == oldHead ? "yes" : "no") << endl;
+
+	// Shorter destination: existing nodes are reused, the rest appended
+	const LinkedList<int>::Node* oldTail = copy.Tail();
+	copy = longList;
+	cout << "Assign longer: ";
+	PrintBothWays(copy);
+	cout << "Third node reused: " << (copy.GetNode(2) == oldTail ? "yes" : "no") << endl;
+
+	LinkedList<int>& alias = copy;
+	copy = alias;
+	cout << "Self-assignment: ";
+	PrintBothWays(copy);
+
+	LinkedList<int> empty;
+	copy = empty;
+	cout << "Assign empty: ";
+	PrintBothWays(copy);
+	copy = shortList;
+	cout << "Assign into emptied: ";
+	PrintBothWays(copy);
+
+	LinkedList<int, PoolAllocator<int>> pooled;
+	pooled.AddNodesTail({ 5, 6 });
+	LinkedList<int, PoolAllocator<int>> pooledCopy(pooled);
+	pooledCopy.AddNodesTail({ 7, 8, 9 });
+	pooled = pooledCopy;
+	cout << "Pooled assign longer: ";
+	PrintBothWays(pooled);
+}
+
+void TestFingerprintCollision()
+{
+	cout << "=====Testing FingerprintedLinkedList fingerprints=====" << endl;
+	FingerprintedLinkedList<int> first;
+	FingerprintedLinkedList<int> second;
+	int firstValues[] = { 1, 2, 1, 3, 1 };
+	int secondValues[] = { 1, 3, 1, 2, 1 };
+	first.AddNodesTail(firstValues, 5);
+	second.AddNodesTail(secondValues, 5);
+
+	// Same neighbouring pairs in another arrangement: a known collision
+	cout << "1 2 1 3 1 vs 1 3 1 2 1 fingerprints: "
+		<< (first.Fingerprint() == second.Fingerprint() ? "collide" : "differ") << endl;
+	cout << "Lists compare " << (first == second ? "equal" : "not equal") << endl;
+
+	FingerprintedLinkedList<int> swapped;
+	int swappedValues[] = { 2, 1, 1, 3, 1 };
+	swapped.AddNodesTail(swappedValues, 5);
+	cout << "1 2 1 3 1 vs 2 1 1 3 1 fingerprints: "
+		<< (first.Fingerprint() == swapped.Fingerprint() ? "collide" : "differ") << endl;
+
+	// Building the same contents by other routes must land on the same value
+	FingerprintedLinkedList<int> rebuilt;
+	rebuilt.AddTail(3);
+	rebuilt.AddHead(1);
+	rebuilt.InsertAt(2, 1);
+	rebuilt.InsertAt(1, 2);
+	rebuilt.AddTail(9);
+	rebuilt.Set(rebuilt.Tail(), 1);
+	cout << "Rebuilt: ";
+	rebuilt.PrintForward();
+	cout << "Rebuilt matches 1 2 1 3 1: " << (rebuilt.Fingerprint() == first.Fingerprint()
+		&& rebuilt == first ? "yes" : "no") << endl;
+
+	unsigned int removed = rebuilt.Remove(1);
+	FingerprintedLinkedList<int> expected;
+	expected.AddTail(2);
+	expected.AddTail(3);
+	cout << "After Remove(1) (" << removed << " nodes) matches 2 3: "
+		<< (rebuilt.Fingerprint() == expected.Fingerprint() ? "yes" : "no") << endl;
+	rebuilt.Clear();
+	FingerprintedLinkedList<int> empty;
+	cout << "Cleared matches empty: " << (rebuilt.Fingerprint() == empty.Fingerprint() ? "yes" : "no") << endl;
+}
+
+void TestRemoveAtEnds()
+{
+	cout << "=====Testing RemoveAt() at the first and last index=====" << endl;
+	LinkedList<int> data;
+	for (int i = 1; i <= 5; i++)
+		data.AddTail(i);
+	data.RemoveAt(0);
+	cout << "RemoveAt(0): ";
+	PrintBothWays(data);
+	data.RemoveAt(data.NodeCount() - 1);
+	cout << "RemoveAt(last): ";
+	PrintBothWays(data);
+	bool removed = data.RemoveAt(data.NodeCount());
+	cout << "RemoveAt(count) returns " << (removed ? "true" : "false") << endl;
+
+	LinkedList<int> single;
+	single.AddTail(42);
+	single.RemoveAt(0); // Head and tail at once
+	cout << "Single node RemoveAt(0): ";
+	PrintBothWays(single);
+	single.AddTail(43); // _head and _tail must both have been reset
+	cout << "Reused: ";
+	PrintBothWays(single);
+
+	SharedLinkedList<int> shared;
+	for (int i = 1; i <= 3; i++)
+		shared.AddTail(i);
+	shared.RemoveAt(0);
+	shared.RemoveAt(shared.NodeCount() - 1);
+	cout << "SharedLinkedList after removing both ends: ";
+	PrintBothWays(*shared.Read());
+}
+
+// Runs on one thread: Leaker's allocation table is not thread-safe, so the
+// multi-threaded split is covered by stress/concurrency_stress.cpp instead
+void TestParallelSerial()
+{
+	cout << "=====Testing ParallelLinkedList helpers on one thread=====" << endl;
+	LinkedList<int> data;
+	for (int i = 0; i < 20; i++)
+		data.AddTail(i % 7);
+
+	vector<LinkedList<int>::Node*> found;
+	ParallelFindAll(data, found, 3, 1);
+	cout << "ParallelFindAll(3): " << found.size() << " nodes at";
+	for (LinkedList<int>::Node* node : found)
+	{
+		unsigned int index = 0;
+		for (auto walk = data.Head(); walk != node; walk = walk->next)
+			index++;
+		cout << " " << index;
+	}
+	cout << endl;
+
+	long long sum = 0;
+	ParallelForEach(static_cast<const LinkedList<int>&>(data), [&sum](const int& value) { sum += value; }, 1);
+	cout << "ParallelForEach sum: " << sum << endl;
+	ParallelForEach(data, [](int& value) { value *= 10; }, 1);
+	cout << "After ParallelForEach *10, head " << data.Head()->data << ", tail " << data.Tail()->data << endl;
+
+	unsigned int removed = ParallelRemove(data, data[0], 1); // Argument aliases a match
+	cout << "ParallelRemove(data[0]) removed " << removed << endl;
+	removed = ParallelRemoveIf(data, [](const int& value) { return value >= 50; }, 1);
+	cout << "ParallelRemoveIf(>= 50) removed " << removed << ": ";
+	PrintBothWays(data);
+
+	LinkedList<int> empty;
+	found.clear();
+	ParallelFindAll(empty, found, 0, 0);
+	cout << "Empty list matches: " << found.size() << endl;
+}
+
+// Element type for the intrusive list tests; byPriority lets one object sit in
+// a second list at the same time
+struct Job
+{
+	int id;
+	IntrusiveListHook<Job> hook;
+	IntrusiveListHook<Job> byPriority;
+	explicit Job(int i) : id(i) {}
+	bool operator==(const Job& other) const { return id == other.id; }
+};
+
+void PrintJobs(const IntrusiveLinkedList<Job>& jobs)
+{
+	cout << "[" << jobs.NodeCount() << "]";
+	for (const Job& job : jobs)
+		cout << " " << job.id;
+	cout << " | reverse:";
+	for (const Job* job = jobs.Tail(); job != nullptr; job = IntrusiveLinkedList<Job>::Prev(*job))
+		cout << " " << job->id;
+	cout << endl;
+}
+
+void TestIntrusiveList()
+{
+	cout << "=====Testing IntrusiveLinkedList=====" << endl;
+	Job jobs[] = { Job(1), Job(2), Job(3), Job(4), Job(5) };
+	IntrusiveLinkedList<Job> queue;
+	IntrusiveLinkedList<Job> other;
+	for (int i = 0; i < 3; i++)
+		queue.AddTail(jobs[i]);
+	other.AddTail(jobs[3]);
+	other.AddTail(jobs[4]);
+	cout << "Queue: ";
+	PrintJobs(queue);
+
+	cout << "IsLinked head/middle/tail: " << queue.IsLinked(jobs[0]) << queue.IsLinked(jobs[1])
+		<< queue.IsLinked(jobs[2]) << ", other list's nodes: " << queue.IsLinked(jobs[3])
+		<< queue.IsLinked(jobs[4]) << endl;
+
+	// A second hook puts the same objects in another order at no cost
+	IntrusiveLinkedList<Job, &Job::byPriority> priority;
+	for (Job& job : jobs)
+		priority.AddHead(job);
+	cout << "By priority head " << priority.Head()->id << ", tail " << priority.Tail()->id << endl;
+
+	queue.Remove(jobs[1]); // Interior, O(1)
+	cout << "Remove middle: ";
+	PrintJobs(queue);
+	cout << "Removed job linked: " << (queue.IsLinked(jobs[1]) ? "yes" : "no") << endl;
+	queue.InsertAt(jobs[1], 0);
+	queue.Remove(jobs[1]); // Head
+	queue.Remove(jobs[2]); // Tail
+	cout << "Remove head and tail: ";
+	PrintJobs(queue);
+
+	Job* none = queue.RemoveAt(5);
+	cout << "RemoveAt(5): " << (none == nullptr ? "nullptr" : "element") << endl;
+	Job* last = queue.RemoveAt(0);
+	cout << "RemoveAt(0) returned job " << last->id << ", queue ";
+	PrintJobs(queue);
+	cout << "Priority list untouched: " << priority.NodeCount() << " jobs" << endl;
+
+	IntrusiveLinkedList<Job> moved(std::move(other));
+	cout << "Moved list: ";
+	PrintJobs(moved);
+	cout << "Moved-from list: ";
+	PrintJobs(other);
+	moved.Clear();
+	cout << "After Clear, job 4 linked: " << (moved.IsLinked(jobs[3]) ? "yes" : "no") << endl;
+	priority.Clear();
+}
+
+void TestSmallListLifetime()
+{
+	cout << "=====Testing SmallLinkedList inline nodes and lifetime=====" << endl;
+	typedef SmallLinkedList<int, 4> Small;
+	typedef remove_cv<remove_reference<decltype(declval<Small&>().List())>::type>::type Plain;
+	// The LinkedList base is private, so a plain list can't steal inline nodes
+	cout << "LinkedList movable from SmallLinkedList: "
+		<< (is_constructible<Plain, Small&&>::value ? "yes" : "no") << endl;
+	cout << "SmallLinkedList converts to LinkedList&: "
+		<< (is_convertible<Small&, Plain&>::value ? "yes" : "no") << endl;
+
+	Small small;
+	for (int i = 1; i <= 6; i++)
+		small.AddTail(i);
+	cout << "6 nodes, " << small.InlineNodeCount() << " inline of " << Small::InlineCapacity() << ": ";
+	PrintBothWays(small);
+	small.RemoveHead(); // Frees an inline slot
+	small.AddTail(7);   // and takes it straight back
+	cout << "After RemoveHead/AddTail, inline " << small.InlineNodeCount() << ": ";
+	PrintBothWays(small);
+
+	Small moved;
+	Plain copy;
+	Small rest;
+	{
+		Small source;
+		source.AddNodesTail({ 10, 20, 30, 40, 50 });
+		moved = std::move(source); // Payloads move into moved's own slots
+		source.AddNodesTail({ 60, 70, 80 });
+		copy = source.List(); // Copies never share the arena
+		rest = source.SplitAfter(source.Head());
+	} // source's inline slots are gone here
+	cout << "Moved out of a dead list: ";
+	PrintBothWays(moved);
+	cout << "Copied from a dead list: ";
+	PrintBothWays(copy);
+	cout << "Split from a dead list: ";
+	PrintBothWays(rest);
+	moved.Splice(nullptr, rest);
+	moved.Sort();
+	cout << "Spliced and sorted, inline " << moved.InlineNodeCount() << ": ";
+	PrintBothWays(moved);
+	Small again(moved);
+	cout << "Copy equals original: " << (again == moved ? "yes" : "no") << endl;
+}
+
+void TestCompactList()
+{
+	cout << "=====Testing CompactLinkedList=====" << endl;
+	CompactLinkedList<int> data;
+	data.Reserve(8);
+	for (int i = 1; i <= 5; i++)
+		data.AddTail(i * 10);
+	data.AddHead(5);
+	CompactLinkedList<int>::Handle forty = data.Find(40);
+	data.InsertAfter(forty, 45);
+	data.InsertBefore(data.Head(), 1);
+	data.InsertAt(25, 4);
+	cout << "Forward:";
+	for (int value : data)
+		cout << " " << value;
+	cout << " | reverse:";
+	for (auto h = data.Tail(); h != CompactLinkedList<int>::NullHandle; h = data.Prev(h))
+		cout << " " << data.Get(h);
+	cout << " | count " << data.NodeCount() << endl;
+
+	// Handles survive the vector reallocating
+	for (int i = 0; i < 100; i++)
+		data.AddTail(1000 + i);
+	cout << "Handle to 40 after growth: " << data.Get(forty) << endl;
+	while (data.NodeCount() > 9)
+		data.RemoveTail();
+
+	// Released slots are reused before the vector grows
+	size_t slots = data.Slots().size();
+	data.RemoveNode(data.Find(25));
+	data.RemoveHead();
+	data.AddTail(60);
+	data.AddTail(70);
+	cout << "Slots after remove/add: " << (data.Slots().size() == slots ? "unchanged" : "grew") << endl;
+
+	data.AddTail(10);
+	vector<CompactLinkedList<int>::Handle> found;
+	data.FindAll(found, 10);
+	cout << "FindAll(10): " << found.size() << " handles, Remove(10): " << data.Remove(10) << endl;
+	cout << "Find(999) is " << (data.Find(999) == CompactLinkedList<int>::NullHandle ? "NullHandle" : "a handle") << endl;
+	bool removed = data.RemoveAt(100);
+	cout << "RemoveAt(100) returns " << (removed ? "true" : "false") << endl;
+
+	CompactLinkedList<int> copy = data; // Trivially copyable slots copy as a block
+	copy[0] = -1;
+	cout << "Copy differs after write: " << (copy == data ? "no" : "yes") << ", original head " << data[0] << endl;
+	data.Clear();
+	cout << "Cleared count " << data.NodeCount() << ", head is "
+		<< (data.Head() == CompactLinkedList<int>::NullHandle ? "NullHandle" : "set") << endl;
+	data.AddTail(3);
+	data.PrintForward();
+}
+
+void TestWriteTo()
+{
+	cout << "=====Testing WriteTo()/WriteReverseTo()=====" << endl;
+	LinkedList<int> small;
+	small.AddNodesTail({ -3, 0, 42, 2147483647 });
+	small.WriteTo(cout, ' ');
+	cout << endl;
+	small.WriteReverseTo(cout, ',');
+	cout << endl;
+
+	// Enough digits to fill the integer buffer several times over
+	LinkedList<long long> big;
+	stringstream expected;
+	stringstream reversed;
+	for (long long i = 0; i < 5000; i++)
+	{
+		big.AddTail(i * 1000003 - 2500000000LL);
+		expected << i * 1000003 - 2500000000LL << '\n';
+	}
+	for (long long i = 4999; i >= 0; i--)
+		reversed << i * 1000003 - 2500000000LL << ';';
+	stringstream forwardOut;
+	stringstream reverseOut;
+	big.WriteTo(forwardOut);
+	big.WriteReverseTo(reverseOut, ';');
+	cout << "5000 values (" << forwardOut.str().size() << " bytes) forward "
+		<< (forwardOut.str() == expected.str() ? "match" : "differ") << ", reverse "
+		<< (reverseOut.str() == reversed.str() ? "match" : "differ") << endl;
+
+	// Stream formatting is honoured by falling back to operator<<
+	stringstream hexOut;
+	hexOut << hex;
+	small.WriteTo(hexOut, ' ');
+	cout << "Hex stream: " << hexOut.str() << endl;
+
+	LinkedList<string> words;
+	words.AddNodesTail({ "alpha", "beta" });
+	words.WriteTo(cout, '|');
+	cout << endl;
+	LinkedList<int> empty;
+	stringstream emptyOut;
+	empty.WriteTo(emptyOut);
+	cout << "Empty list wrote " << emptyOut.str().size() << " bytes" << endl;
+}
+
+// Loads snapshot into list and reports the error, if any, on one line
+template <typename List>
+void TryLoad(const char* label, List& list, const string& snapshot)
+{
+	stringstream in(snapshot);
+	try
+	{
+		LoadBinary(list, in);
+		cout << label << ": loaded " << list.NodeCount() << " nodes" << endl;
+	}
+	catch (const runtime_error& e)
+	{
+		cout << label << ": " << e.what() << " List still has " << list.NodeCount() << " nodes" << endl;
+	}
+}
+
+void TestSnapshots()
+{
+	cout << "=====Testing snapshot save/load=====" << endl;
+	LinkedList<int> source;
+	for (int i = 0; i < 20000; i++) // More than one 64 KiB chunk
+		source.AddTail(i * 7 - 1000);
+	stringstream out;
+	SaveBinary(source, out);
+	string snapshot = out.str();
+	cout << "Snapshot bytes: " << snapshot.size() << endl;
+
+	LinkedList<int> loaded;
+	loaded.AddTail(99); // Replaced by a successful load
+	TryLoad("Round trip", loaded, snapshot);
+	cout << "Round trip equal: " << (loaded == source ? "yes" : "no") << endl;
+
+	string flipped = snapshot;
+	flipped[100] ^= 0x01; // One payload bit
+	TryLoad("Flipped payload bit", loaded, flipped);
+	TryLoad("Truncated", loaded, snapshot.substr(0, snapshot.size() - 3));
+	string badMagic = snapshot;
+	badMagic[0] ^= 0x55;
+	TryLoad("Bad magic", loaded, badMagic);
+	LinkedList<long long> wide;
+	TryLoad("Wrong element type", wide, snapshot);
+	TryLoad("Empty input", loaded, "");
+
+	LinkedList<int> empty;
+	stringstream emptyOut;
+	SaveBinary(empty, emptyOut);
+	LinkedList<int> emptyLoaded;
+	TryLoad("Empty list", emptyLoaded, emptyOut.str());
+
+	LinkedList<string> words;
+	words.AddNodesTail({ "snap", "", "shot with spaces" });
+	stringstream wordsOut;
+	SaveBinary(words, wordsOut, StringSerializer());
+	LinkedList<string> wordsLoaded;
+	stringstream wordsIn(wordsOut.str());
+	LoadBinary(wordsLoaded, wordsIn, StringSerializer());
+	cout << "Strings round trip: ";
+	wordsLoaded.WriteTo(cout, '|');
+	cout << " equal: " << (wordsLoaded == words ? "yes" : "no") << endl;
+}
+
+void TestCompactStats()
+{
+	cout << "=====Testing Compact() statistics=====" << endl;
+	// Scatter a pooled list: insert each new node next to a far-away one so
+	// list order jumps between pool pages
+	LinkedList<long long, PoolAllocator<long long>> pooled;
+	for (int i = 0; i < 4000; i++)
+	{
+		if (pooled.NodeCount() < 2)
+			pooled.AddTail(i);
+		else
+			pooled.InsertAfter(pooled.GetNode((i * 7919) % pooled.NodeCount()), i);
+	}
+	pooled.RemoveIf([](const long long& value) { return value % 3 == 0; });
+	vector<long long> before(pooled.begin(), pooled.end()); // Off the pool
+	LinkedListCompactStats stats = pooled.Compact();
+	cout << "Contents unchanged: " << (equal(before.begin(), before.end(), pooled.begin())
+		&& before.size() == pooled.NodeCount() ? "yes" : "no") << endl;
+	cout << "Page switches saved: " << (stats.page_switches_saved > 0 ? "some" : "none") << endl;
+	cout << "Bytes reclaimed: " << (stats.bytes_reclaimed > 0 ? "some" : "none") << endl;
+	// Already in traversal order; only where the new block starts within a
+	// page can change the count
+	stats = pooled.Compact();
+	cout << "Second Compact saves at most one switch: " << (stats.page_switches_saved <= 1 ? "yes" : "no") << endl;
+	stats = pooled.Compact(false);
+	cout << "Compact(false) reclaims " << stats.bytes_reclaimed << " bytes" << endl;
+
+	LinkedList<int> plain;
+	plain.AddNodesTail({ 3, 1, 2 });
+	stats = plain.Compact();
+	cout << "Without a pool, bytes reclaimed " << stats.bytes_reclaimed << ": ";
+	PrintBothWays(plain);
+	LinkedList<int> empty;
+	stats = empty.Compact();
+	cout << "Empty list: " << stats.bytes_reclaimed << " bytes, " << stats.page_switches_saved << " switches" << endl;
+}
+
+void TestTwoCursorSearch()
+{
+	cout << "=====Testing two-cursor Find()/FindAll() and nearer-end indexing=====" << endl;
+	LinkedList<int> data;
+	// 200 matches, more of them in the back half than FindAll buffers
+	for (int i = 0; i < 400; i++)
+		data.AddTail(i % 2 == 0 ? -7 : i);
+	vector<LinkedList<int>::Node*> found;
+	data.FindAll(found, -7);
+	bool inOrder = found.size() == 200;
+	for (size_t i = 0; inOrder && i < found.size(); i++)
+		inOrder = found[i] == data.GetNode((unsigned int)i * 2);
+	cout << "FindAll(-7): " << found.size() << " nodes, in list order: " << (inOrder ? "yes" : "no") << endl;
+
+	found.clear();
+	data.FindAll(found, 399); // Only match is the tail
+	cout << "FindAll(399) finds the tail: " << (found.size() == 1 && found[0] == data.Tail() ? "yes" : "no") << endl;
+	cout << "Find(-7) is the head: " << (data.Find(-7) == data.Head() ? "yes" : "no") << endl;
+	cout << "Find(397) is the third from last: " << (data.Find(397) == data.Tail()->prev->prev ? "yes" : "no") << endl;
+	cout << "Find(4) is " << (data.Find(4) == nullptr ? "nullptr" : "a node") << endl;
+
+	LinkedList<int> odd;
+	odd.AddNodesTail({ 1, 2, 3 });
+	cout << "Odd-length Find(2) is the middle: " << (odd.Find(2) == odd.GetNode(1) ? "yes" : "no") << endl;
+
+	cout << "data[1] " << data[1] << ", data[397] " << data[397] << ", data[399] " << data[399] << endl;
+	data[398] = -1; // Reached from the tail
+	cout << "After write, Tail()->prev holds " << data.Tail()->prev->data << endl;
+	try
+	{
+		cout << data[400] << endl;
+	}
+	catch (const out_of_range& e)
+	{
+		cout << "data[400]: " << e.what() << endl;
+	}
+
+	LinkedList<int> copy(data);
+	cout << "Copy == original: " << (copy == data ? "yes" : "no") << endl;
+	copy.RemoveTail();
+	cout << "Shorter copy == original: " << (copy == data ? "yes" : "no") << endl;
+	copy.AddTail(0);
+	cout << "Different tail == original: " << (copy == data ? "yes" : "no") << endl;
+}
+
+// Counts destructor calls so the test can see where nodes were released
+struct Tracked
+{
+	static int destroyed;
+	int value;
+	Tracked(int v) : value(v) {}
+	~Tracked() { destroyed++; }
+};
+int Tracked::destroyed = 0;
+
+// Leaker's table is not thread-safe, so every deferred release is followed
+// straight away by Drain(): the main thread allocates nothing while the
+// reclaimer thread is freeing nodes
+void TestNodeReclaimer()
+{
+	cout << "=====Testing deferred release through NodeReclaimer=====" << endl;
+	NodeReclaimer reclaimer;
+	{
+		LinkedList<Tracked> data;
+		data.SetReclaimer(&reclaimer);
+		for (int i = 0; i < 1000; i++)
+			data.EmplaceTail(i);
+		Tracked::destroyed = 0;
+		data.Clear();
+		reclaimer.Drain();
+		cout << "Clear: list count " << data.NodeCount() << ", destroyed after Drain "
+			<< Tracked::destroyed << ", pending " << reclaimer.Pending() << endl;
+
+		data.EmplaceTail(1); // The cleared list is usable again
+		data.EmplaceTail(2);
+		LinkedList<Tracked> moved(std::move(data)); // Adopts the reclaimer
+		Tracked::destroyed = 0;
+		moved.RemoveIf([](const Tracked& item) { return item.value == 1; });
+		reclaimer.Drain();
+		cout << "RemoveIf destroyed " << Tracked::destroyed << ", " << moved.NodeCount() << " left" << endl;
+		Tracked::destroyed = 0;
+	} // moved's destructor defers its last node
+	reclaimer.Drain();
+	cout << "Destructor released " << Tracked::destroyed << " node" << endl;
+
+	// A pool allocator is not safe to use from the reclaimer thread, so its
+	// nodes are released on the spot
+	LinkedList<int, PoolAllocator<int>> pooled;
+	pooled.SetReclaimer(&reclaimer);
+	pooled.AddNodesTail({ 1, 2, 3 });
+	pooled.Clear();
+	cout << "Pooled Clear pending: " << reclaimer.Pending() << endl;
+	pooled.SetReclaimer(nullptr);
+}
+
+void TestCowUnsharing()
+{
+	cout << "=====Testing CowLinkedList sharing and unsharing=====" << endl;
+	CowLinkedList<int> original;
+	int values[] = { 1, 2, 3 };
+	original.AddNodesTail(values, 3);
+	CowLinkedList<int> copy = original;
+	cout << "After copy, shared: " << (original.IsShared() && copy.IsShared() ? "yes" : "no")
+		<< ", same nodes: " << (copy.Head() == original.Head() ? "yes" : "no") << endl;
+
+	// Const access never clones
+	const CowLinkedList<int>& view = copy;
+	cout << "Const read " << view[1] << ", still shared: " << (copy.IsShared() ? "yes" : "no") << endl;
+
+	copy.AddTail(4); // First write clones
+	cout << "After write, shared: " << (original.IsShared() || copy.IsShared() ? "yes" : "no")
+		<< ", same nodes: " << (copy.Head() == original.Head() ? "yes" : "no") << endl;
+	cout << "Original: ";
+	original.PrintForward();
+	cout << "Copy: ";
+	copy.PrintForward();
+
+	CowLinkedList<int> third = copy;
+	third[0] = 100; // Non-const operator[] clones before handing out the reference
+	cout << "After third[0] = 100, copy[0] " << static_cast<const CowLinkedList<int>&>(copy)[0]
+		<< ", third[0] " << static_cast<const CowLinkedList<int>&>(third)[0] << endl;
+
+	CowLinkedList<int> fourth = third;
+	fourth.MutableList().Sort(); // Unshares like any other mutation
+	third.Clear();               // Drops only third's reference
+	cout << "Fourth after third's Clear: " << fourth.NodeCount() << " nodes, shared "
+		<< (fourth.IsShared() ? "yes" : "no") << endl;
+	cout << "Cleared list empty and unshared: "
+		<< (third.NodeCount() == 0 && !third.IsShared() ? "yes" : "no") << endl;
+	third.AddTail(7);
+	cout << "Cleared list reusable: " << third.NodeCount() << " node" << endl;
+
+	CowLinkedList<int> moved(std::move(fourth));
+	cout << "Moved-from count " << fourth.NodeCount() << ", moved count " << moved.NodeCount() << endl;
+}
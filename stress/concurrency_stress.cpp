@@ -0,0 +1,277 @@
+// Multi-threaded stress checks for the concurrent containers. These live
+// apart from main.cpp because Leaker's replacement operator new/delete keep an
+// unsynchronised table and cannot be called from several threads at once.
+//
+// Build and run from the repository root (the test number is read from
+// stdin, as in main.cpp):
+//   g++ -std=c++17 -O2 -pthread -I. stress/concurrency_stress.cpp -o stress
+//   echo 1 | ./stress
+// Tests: 1 ConcurrentLinkedQueue, 2 SharedLinkedList, 3 PersistentLinkedList,
+// 4 ParallelLinkedList.
+// Adding -fsanitize=thread checks the runs for data races as well.
+
+#include <atomic>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentLinkedQueue.h"
+#include "ParallelLinkedList.h"
+#include "PersistentLinkedList.h"
+#include "SharedLinkedList.h"
+
+using namespace std;
+
+void TestQueueStress();
+void TestSharedListStress();
+void TestPersistentListStress();
+void TestParallelScans();
+
+int main()
+{
+	int testNum;
+	cin >> testNum;
+	if (testNum == 1)
+		TestQueueStress();
+	else if (testNum == 2)
+		TestSharedListStress();
+	else if (testNum == 3)
+		TestPersistentListStress();
+	else if (testNum == 4)
+		TestParallelScans();
+
+	return 0;
+}
+
+// Producers push single values and two-element batches while consumers pop
+// one at a time or in batches; every value must come out exactly once
+void TestQueueStress()
+{
+	cout << "=====Stress testing ConcurrentLinkedQueue=====" << endl;
+	const int producers = 4;
+	const int consumers = 4;
+	const int perProducer = 20000;
+	const int total = producers * perProducer;
+	ConcurrentLinkedQueue<int> queue;
+	vector<long long> sums(consumers, 0);
+	vector<int> counts(consumers, 0);
+	vector<thread> threads;
+
+	for (int p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&queue]() {
+			for (int i = 1; i <= perProducer; i += 2)
+			{
+				if (i % 4 == 1)
+				{
+					int pair[2] = { i, i + 1 };
+					queue.PushTailBatch(pair, pair + 2);
+				}
+				else
+				{
+					queue.PushTail(i);
+					queue.EmplaceTail(i + 1);
+				}
+			}
+		});
+	}
+	for (int c = 0; c < consumers; c++)
+	{
+		threads.emplace_back([&queue, &sums, &counts, c]() {
+			int buffer[16];
+			while (counts[c] < total / consumers)
+			{
+				size_t got = 0;
+				if (c % 2 == 0)
+				{
+					size_t want = total / consumers - counts[c];
+					got = queue.PopHeadBatch(buffer, want < 16 ? want : 16);
+				}
+				else if (optional<int> value = queue.TryPopHead())
+				{
+					buffer[0] = *value;
+					got = 1;
+				}
+				for (size_t i = 0; i < got; i++)
+					sums[c] += buffer[i];
+				counts[c] += (int)got;
+			}
+		});
+	}
+	for (thread& t : threads)
+		t.join();
+
+	long long sum = 0;
+	int count = 0;
+	for (int c = 0; c < consumers; c++)
+	{
+		sum += sums[c];
+		count += counts[c];
+	}
+	long long expected = (long long)producers * perProducer * (perProducer + 1) / 2;
+	cout << "Popped " << count << " of " << total << " values" << endl;
+	cout << "Sum " << (sum == expected ? "matches" : "does not match") << endl;
+	cout << "Queue is " << (queue.Empty() ? "empty" : "not empty") << endl;
+}
+
+// Writers keep every published version sorted and duplicate-free while
+// readers walk snapshots; a reader must never see a partial update
+void TestSharedListStress()
+{
+	cout << "=====Stress testing SharedLinkedList=====" << endl;
+	const int writers = 2;
+	const int readers = 4;
+	const int perWriter = 1000;
+	SharedLinkedList<int> list;
+	vector<int> bad(readers, 0);
+	atomic<int> writing(writers);
+	vector<thread> threads;
+
+	for (int w = 0; w < writers; w++)
+	{
+		threads.emplace_back([&list, &writing, w]() {
+			for (int i = 0; i < perWriter; i++)
+			{
+				int value = i * writers + w;
+				// Insert and restore order in one published step
+				list.Update([value](LinkedList<int>& copy) {
+					copy.AddTail(value);
+					copy.Sort();
+				});
+				if (value % 3 == 0)
+					list.Remove(value); // Removal keeps the order on its own
+			}
+			writing--;
+		});
+	}
+	for (int r = 0; r < readers; r++)
+	{
+		threads.emplace_back([&list, &writing, &bad, r]() {
+			do
+			{
+				SharedLinkedList<int>::Snapshot snapshot = list.Read();
+				const LinkedList<int>::Node* node = snapshot->Head();
+				unsigned int seen = 0;
+				for (; node != nullptr; node = node->next, seen++)
+				{
+					if (node->next != nullptr && node->next->data <= node->data)
+						bad[r]++;
+				}
+				if (seen != snapshot->NodeCount())
+					bad[r]++;
+			} while (writing > 0);
+		});
+	}
+	for (thread& t : threads)
+		t.join();
+
+	int errors = 0;
+	for (int r = 0; r < readers; r++)
+		errors += bad[r];
+	unsigned int expected = 0;
+	for (int value = 0; value < writers * perWriter; value++)
+		expected += value % 3 != 0;
+	cout << "Readers saw " << (errors == 0 ? "only consistent" : "inconsistent")
+		<< " snapshots" << endl;
+	cout << "Final size " << (list.NodeCount() == expected ? "matches" : "does not match") << endl;
+}
+
+// Every published version holds 0, 1, 2, ... in order. One writer grows and
+// shrinks the tail while another rewrites values in place; readers check each
+// version they take against its own NodeCount
+void TestPersistentListStress()
+{
+	cout << "=====Stress testing PersistentLinkedList=====" << endl;
+	const int readers = 4;
+	const unsigned int floor = 100;
+	const unsigned int steps = 20000;
+	PersistentLinkedList<unsigned int> list;
+	for (unsigned int i = 0; i < floor; i++)
+		list.AddTail(i);
+	vector<int> bad(readers, 0);
+	atomic<int> writing(2);
+	vector<thread> threads;
+
+	threads.emplace_back([&list, &writing]() {
+		for (unsigned int step = 0; step < steps; step++)
+		{
+			list.AddTail(list.NodeCount()); // Only this thread changes the size
+			if (step % 3 == 2)
+				list.RemoveAt(list.NodeCount() - 1);
+		}
+		writing--;
+	});
+	threads.emplace_back([&list, &writing]() {
+		for (unsigned int step = 0; step < steps; step++)
+		{
+			unsigned int index = (step * 7919) % floor; // Never above the floor
+			list.Set(index, index);
+		}
+		writing--;
+	});
+	for (int r = 0; r < readers; r++)
+	{
+		threads.emplace_back([&list, &writing, &bad, r]() {
+			do
+			{
+				PersistentLinkedList<unsigned int>::Version version = list.Snapshot();
+				unsigned int expected = 0;
+				for (unsigned int value : version)
+				{
+					if (value != expected)
+						bad[r]++;
+					expected++;
+				}
+				if (expected != version.NodeCount() || expected < floor)
+					bad[r]++;
+			} while (writing > 0);
+		});
+	}
+	for (thread& t : threads)
+		t.join();
+
+	int errors = 0;
+	for (int r = 0; r < readers; r++)
+		errors += bad[r];
+	cout << "Readers saw " << (errors == 0 ? "only consistent" : "inconsistent")
+		<< " versions" << endl;
+	unsigned int expected = floor + steps - steps / 3;
+	cout << "Final size " << (list.NodeCount() == expected ? "matches" : "does not match") << endl;
+}
+
+// Scans a list long enough to be split across four threads and checks each
+// parallel helper against the serial LinkedList result, including list order
+void TestParallelScans()
+{
+	cout << "=====Stress testing ParallelLinkedList=====" << endl;
+	const unsigned int threads = 4;
+	const int size = 200000;
+	LinkedList<int> list;
+	for (int i = 0; i < size; i++)
+		list.AddTail(i % 1000);
+
+	vector<LinkedList<int>::Node*> serial;
+	vector<LinkedList<int>::Node*> parallel;
+	list.FindAll(serial, 123);
+	ParallelFindAll(list, parallel, 123, threads);
+	cout << "ParallelFindAll " << (parallel == serial ? "matches" : "does not match")
+		<< " FindAll (" << parallel.size() << " nodes)" << endl;
+
+	atomic<long long> sum(0);
+	ParallelForEach(list, [&sum](int& value) { sum += value; }, threads);
+	long long expected = (long long)(size / 1000) * (999 * 1000 / 2);
+	cout << "ParallelForEach sum " << (sum == expected ? "matches" : "does not match") << endl;
+
+	unsigned int removed = ParallelRemoveIf(list, [](const int& value) { return value % 2 == 1; }, threads);
+	bool ordered = true;
+	int previous = -1;
+	for (const LinkedList<int>::Node* node = list.Head(); node != nullptr; node = node->next)
+	{
+		if (node->data % 2 == 1 || (node->data != 0 && node->data != previous + 2))
+			ordered = false;
+		previous = node->data;
+	}
+	cout << "ParallelRemoveIf removed " << removed << ", remaining list "
+		<< (ordered && list.NodeCount() == (unsigned int)size - removed ? "intact" : "damaged") << endl;
+}